@@ -66,6 +66,9 @@ if(CMAKE_GENERATOR MATCHES "Make")
   if(DEFINED CMAKE_RULE_MESSAGES)
     set_property(GLOBAL PROPERTY RULE_MESSAGES ${CMAKE_RULE_MESSAGES})
   endif()
+  if(DEFINED CMAKE_RULE_PROGRESS)
+    set_property(GLOBAL PROPERTY RULE_PROGRESS ${CMAKE_RULE_PROGRESS})
+  endif()
   if(DEFINED CMAKE_TARGET_MESSAGES)
     set_property(GLOBAL PROPERTY TARGET_MESSAGES ${CMAKE_TARGET_MESSAGES})
   endif()
@@ -323,6 +323,13 @@ installers.  The most commonly-used variables are:
     Supported if CMake is built with libarchive 3.6 or higher.
     Official CMake binaries available on ``cmake.org`` support it.
 
+  ``gzip``, ``bzip2``
+    .. versionadded:: 3.31
+
+    The archive is split into independent blocks that are compressed
+    concurrently and stored as consecutive gzip members or bzip2 streams.
+    Standard decompressors read them as a single stream.
+
   Other compression methods ignore this value and use only one thread.
 
 Variables for Source Package Generators
@@ -164,6 +164,10 @@ URL
   to be avoided altogether if the local directory already has a file from
   an earlier download that matches the specified hash.
 
+  .. versionadded:: 3.31
+    If a :variable:`CMAKE_DOWNLOAD_CACHE_DIR` is set, the archive and its
+    extracted contents are shared through the cache with other build trees.
+
 ``URL_MD5 <md5>``
   Equivalent to ``URL_HASH MD5=<md5>``.
 
@@ -546,6 +546,19 @@ function(_ep_write_gitupdate_script
 endfunction()
 
 
+# Get code for a generated script to set download_cache_dir.  Use the
+# CMAKE_DOWNLOAD_CACHE_DIR variable of the project, if any.  Otherwise the
+# script consults the environment variable of the same name when it runs.
+function(_ep_get_download_cache_code out_var)
+  if(DEFINED CMAKE_DOWNLOAD_CACHE_DIR)
+    set(dir "${CMAKE_DOWNLOAD_CACHE_DIR}")
+  else()
+    set(dir "\$ENV{CMAKE_DOWNLOAD_CACHE_DIR}")
+  endif()
+  set(${out_var} "set(download_cache_dir \"${dir}\")" PARENT_SCOPE)
+endfunction()
+
+
 function(_ep_write_downloadfile_script
   script_filename
   REMOTE
@@ -647,10 +660,13 @@ function(_ep_write_downloadfile_script
     endforeach()
   endif()
 
+  _ep_get_download_cache_code(DOWNLOAD_CACHE_CODE)
+
   # Used variables:
   # * TLS_VERSION_CODE
   # * TLS_VERIFY_CODE
   # * TLS_CAINFO_CODE
+  # * DOWNLOAD_CACHE_CODE
   # * ALGO
   # * EXPECT_VALUE
   # * REMOTE
@@ -700,6 +716,7 @@ function(_ep_write_extractfile_script
   filename
   directory
   options
+  hash
 )
   set(args "")
 
@@ -719,6 +736,17 @@ function(_ep_write_extractfile_script
     )
   endif()
 
+  _ep_get_hash_regex(_ep_hash_regex)
+  if("${hash}" MATCHES "${_ep_hash_regex}")
+    set(ALGO "${CMAKE_MATCH_1}")
+    string(TOLOWER "${CMAKE_MATCH_2}" EXPECT_VALUE)
+  else()
+    set(ALGO "")
+    set(EXPECT_VALUE "")
+  endif()
+
+  _ep_get_download_cache_code(DOWNLOAD_CACHE_CODE)
+
   configure_file(
     "${CMAKE_CURRENT_FUNCTION_LIST_DIR}/extractfile.cmake.in"
     "${script_filename}"
@@ -1304,6 +1332,7 @@ hash=${hash}
           "${file}"
           "${source_dir}"
           "${options}"
+          "${hash}"
         )
         list(APPEND cmd
           COMMAND ${CMAKE_COMMAND}
@@ -3,20 +3,29 @@
 #include "cmCTestCoverageHandler.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <iomanip>
 #include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <ratio>
 #include <sstream>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
+#include <cm/optional>
 #include <cmext/algorithm>
 
+#include <cm3p/json/reader.h>
+#include <cm3p/json/value.h>
+
 #include "cmsys/FStream.hxx"
 #include "cmsys/Glob.hxx"
 #include "cmsys/RegularExpression.hxx"
@@ -857,6 +866,133 @@ int cmCTestCoverageHandler::HandleBlanketJSCoverage(
   }
   return static_cast<int>(cont->TotalCoverage.size());
 }
+// Parse the line counts from one gcov text output file.
+static bool ParseGCovFile(
+  std::string const& gcovFile,
+  cmCTestCoverageHandlerContainer::SingleFileCoverageVector& vec)
+{
+  cmsys::ifstream ifile(gcovFile.c_str());
+  if (!ifile) {
+    return false;
+  }
+  std::string nl;
+  while (cmSystemTools::GetLineFromStream(ifile, nl)) {
+    // Skip empty lines
+    if (nl.empty()) {
+      continue;
+    }
+
+    // Skip unused lines
+    if (nl.size() < 12) {
+      continue;
+    }
+
+    // Handle gcov 3.0 non-coverage lines
+    // non-coverage lines seem to always start with something not
+    // a space and don't have a ':' in the 9th position
+    // TODO: Verify that this is actually a robust metric
+    if (nl[0] != ' ' && nl[9] != ':') {
+      continue;
+    }
+
+    // Read the coverage count from the beginning of the gcov output
+    // line
+    std::string prefix = nl.substr(0, 12);
+    int cov = atoi(prefix.c_str());
+
+    // Read the line number starting at the 10th character of the gcov
+    // output line
+    std::string lineNumber = nl.substr(10, 5);
+
+    int lineIdx = atoi(lineNumber.c_str()) - 1;
+    if (lineIdx >= 0) {
+      while (vec.size() <= static_cast<size_t>(lineIdx)) {
+        vec.push_back(-1);
+      }
+
+      // Initially all entries are -1 (not used). If we get coverage
+      // information, increment it to 0 first.
+      if (vec[lineIdx] < 0) {
+        if (cov > 0 || prefix.find('#') != std::string::npos) {
+          vec[lineIdx] = 0;
+        }
+      }
+
+      vec[lineIdx] += cov;
+    }
+  }
+  return true;
+}
+
+// Parse the line counts of each source from gcov JSON intermediate format.
+static bool ParseGCovJSON(
+  std::string const& output,
+  std::vector<std::pair<
+    std::string, cmCTestCoverageHandlerContainer::SingleFileCoverageVector>>&
+    sources)
+{
+  Json::Value root;
+  Json::Reader reader;
+  if (!reader.parse(output, root, false) || !root.isObject() ||
+      !root["files"].isArray()) {
+    return false;
+  }
+
+  // Source paths are relative to the directory the object was compiled in.
+  std::string const cwd = root["current_working_directory"].isString()
+    ? root["current_working_directory"].asString()
+    : std::string();
+  for (Json::Value const& file : root["files"]) {
+    Json::Value const& path = file["file"];
+    if (!path.isString()) {
+      return false;
+    }
+    std::string sourceFile = path.asString();
+    if (!cwd.empty()) {
+      sourceFile = cmSystemTools::CollapseFullPath(sourceFile, cwd);
+    }
+
+    cmCTestCoverageHandlerContainer::SingleFileCoverageVector counts;
+    for (Json::Value const& line : file["lines"]) {
+      Json::Value const& lineNumber = line["line_number"];
+      Json::Value const& count = line["count"];
+      if (!lineNumber.isIntegral() || !count.isIntegral() ||
+          lineNumber.asLargestInt() < 1) {
+        continue;
+      }
+      size_t const lineIdx =
+        static_cast<size_t>(lineNumber.asLargestInt() - 1);
+      if (counts.size() <= lineIdx) {
+        counts.resize(lineIdx + 1, -1);
+      }
+      if (counts[lineIdx] < 0) {
+        counts[lineIdx] = 0;
+      }
+      counts[lineIdx] += static_cast<int>(count.asLargestInt());
+    }
+    sources.emplace_back(std::move(sourceFile), std::move(counts));
+  }
+  return true;
+}
+
+// Add the line counts parsed from one gcov file to the totals of a source.
+static void MergeGCovCounts(
+  cmCTestCoverageHandlerContainer::SingleFileCoverageVector& vec,
+  cmCTestCoverageHandlerContainer::SingleFileCoverageVector const& counts)
+{
+  if (vec.size() < counts.size()) {
+    vec.resize(counts.size(), -1);
+  }
+  for (size_t i = 0; i < counts.size(); ++i) {
+    if (counts[i] >= 0) {
+      if (vec[i] < 0) {
+        vec[i] = 0;
+      }
+      vec[i] += counts[i];
+    }
+  }
+}
+
 int cmCTestCoverageHandler::HandleGCovCoverage(
   cmCTestCoverageHandlerContainer* cont)
 {
@@ -939,35 +1075,232 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
   std::vector<std::string> basecovargs =
     cmSystemTools::ParseArguments(gcovExtraFlags);
   basecovargs.insert(basecovargs.begin(), gcovCommand);
+
+  // Prefer the JSON intermediate format on stdout if gcov supports it.
+  // This avoids writing and reading back a .gcov file per source.
+  std::vector<std::string> jsoncovargs;
+  {
+    std::vector<std::string> helpargs = basecovargs;
+    helpargs.emplace_back("--help");
+    std::string output;
+    std::string errors;
+    int retVal = 0;
+    if (this->CTest->RunCommand(helpargs, &output, &errors, &retVal, nullptr,
+                                cmDuration::zero()) &&
+        output.find("--json-format") != std::string::npos &&
+        output.find("--stdout") != std::string::npos) {
+      jsoncovargs = basecovargs;
+      jsoncovargs.emplace_back("--json-format");
+      jsoncovargs.emplace_back("--stdout");
+      jsoncovargs.emplace_back("-o");
+    }
+  }
   basecovargs.emplace_back("-o");
 
+  // Run gcov on the coverage files concurrently, as many at a time as the
+  // ctest parallel level allows.  Each worker runs gcov in a directory of
+  // its own because gcov writes its .gcov files to the working directory,
+  // and parses the files it reports before running gcov again.
+  struct GCovRun
+  {
+    std::vector<std::string> Command;
+    std::string Output;
+    std::string Errors;
+    int RetVal = 0;
+    bool Res = false;
+    std::map<std::string,
+             cmCTestCoverageHandlerContainer::SingleFileCoverageVector>
+      Counts;
+    bool JSON = false;
+    std::vector<std::pair<
+      std::string, cmCTestCoverageHandlerContainer::SingleFileCoverageVector>>
+      Sources;
+    bool Done = false;
+  };
+  std::vector<GCovRun> runs(files.size());
+
+  size_t workerCount = 1;
+  cm::optional<size_t> parallelLevel = this->CTest->GetParallelLevel();
+  if (!parallelLevel || *parallelLevel == 0) {
+    workerCount = std::thread::hardware_concurrency();
+  } else {
+    workerCount = *parallelLevel;
+  }
+  workerCount = std::max<size_t>(1, std::min(workerCount, files.size()));
+
+  std::vector<std::string> workerDirs;
+  if (workerCount == 1) {
+    workerDirs.push_back(tempDir);
+  } else {
+    for (size_t i = 0; i < workerCount; ++i) {
+      std::string workerDir = cmStrCat(tempDir, "/gcov", i);
+      if (!cmSystemTools::MakeDirectory(workerDir)) {
+        cmCTestLog(this->CTest, ERROR_MESSAGE,
+                   "Unable to make directory: " << workerDir << std::endl);
+        cont->Error++;
+        return 0;
+      }
+      workerDirs.push_back(std::move(workerDir));
+    }
+  }
+
+  std::atomic<size_t> nextRun(0);
+  std::mutex runMutex;
+  std::condition_variable runDone;
+  auto runGCov = [this, &files, &basecovargs, &jsoncovargs, &runs, &nextRun,
+                  &runMutex, &runDone, &st1gcovOutputRex2,
+                  &st2gcovOutputRex3](std::string const& workerDir) {
+    cmsys::RegularExpression createdRex1(st1gcovOutputRex2);
+    cmsys::RegularExpression createdRex2(st2gcovOutputRex3);
+    for (size_t i = nextRun++; i < files.size(); i = nextRun++) {
+      std::string const& f = files[i];
+      GCovRun& run = runs[i];
+
+      // Call gcov to get coverage data for this *.gcda file:
+      //
+      if (!jsoncovargs.empty()) {
+        run.Command = jsoncovargs;
+        run.Command.push_back(cmSystemTools::GetFilenamePath(f));
+        run.Command.push_back(f);
+        run.Res = this->CTest->RunCommand(
+          run.Command, &run.Output, &run.Errors, &run.RetVal,
+          workerDir.c_str(), cmDuration::zero() /*this->TimeOut*/);
+        run.JSON = run.Res && run.RetVal == 0 &&
+          ParseGCovJSON(run.Output, run.Sources);
+        if (!run.JSON) {
+          // Fall back to the text format.
+          run.Sources.clear();
+        }
+      }
+      if (!run.JSON) {
+        run.Command = basecovargs;
+        run.Command.push_back(cmSystemTools::GetFilenamePath(f));
+        run.Command.push_back(f);
+        run.Res = this->CTest->RunCommand(
+          run.Command, &run.Output, &run.Errors, &run.RetVal,
+          workerDir.c_str(), cmDuration::zero() /*this->TimeOut*/);
+      }
+
+      // Parse the .gcov files before the next run may overwrite them.
+      if (run.Res && !run.JSON) {
+        std::vector<std::string> lines;
+        cmsys::SystemTools::Split(run.Output, lines);
+        for (std::string const& line : lines) {
+          std::string gcovFile;
+          if (createdRex1.find(line)) {
+            gcovFile = createdRex1.match(1);
+          } else if (createdRex2.find(line)) {
+            gcovFile = createdRex2.match(2);
+          }
+          if (gcovFile.empty() || run.Counts.count(gcovFile)) {
+            continue;
+          }
+          cmCTestCoverageHandlerContainer::SingleFileCoverageVector counts;
+          if (ParseGCovFile(
+                cmSystemTools::CollapseFullPath(gcovFile, workerDir),
+                counts)) {
+            run.Counts[gcovFile] = std::move(counts);
+          }
+        }
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(runMutex);
+        run.Done = true;
+      }
+      runDone.notify_all();
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(workerDirs.size());
+  for (std::string const& workerDir : workerDirs) {
+    workers.emplace_back(runGCov, std::cref(workerDir));
+  }
+
+  // Find the file in the source or binary tree that gcov reported.
+  auto findActualSourceFile =
+    [this, cont, &missingFiles](std::string const& sourceFile) {
+      std::string actualFile;
+
+      // Is it in the source dir or the binary dir?
+      //
+      if (IsFileInDir(sourceFile, cont->SourceDir)) {
+        cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
+                           "   produced s: " << sourceFile << std::endl,
+                           this->Quiet);
+        *cont->OFS << "  produced in source dir: " << sourceFile
+                   << std::endl;
+        actualFile = cmSystemTools::CollapseFullPath(sourceFile);
+      } else if (IsFileInDir(sourceFile, cont->BinaryDir)) {
+        cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
+                           "   produced b: " << sourceFile << std::endl,
+                           this->Quiet);
+        *cont->OFS << "  produced in binary dir: " << sourceFile
+                   << std::endl;
+        actualFile = cmSystemTools::CollapseFullPath(sourceFile);
+      }
+
+      if (actualFile.empty()) {
+        if (missingFiles.find(sourceFile) == missingFiles.end()) {
+          cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
+                             "Something went wrong" << std::endl,
+                             this->Quiet);
+          cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
+                             "Cannot find file: [" << sourceFile << "]"
+                                                   << std::endl,
+                             this->Quiet);
+          cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
+                             " in source dir: [" << cont->SourceDir << "]"
+                                                 << std::endl,
+                             this->Quiet);
+          cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
+                             " or binary dir: [" << cont->BinaryDir.size()
+                                                 << "]" << std::endl,
+                             this->Quiet);
+          *cont->OFS << "  Something went wrong. Cannot find file: "
+                     << sourceFile << " in source dir: " << cont->SourceDir
+                     << " or binary dir: " << cont->BinaryDir << std::endl;
+
+          missingFiles.insert(sourceFile);
+        }
+      }
+
+      return actualFile;
+    };
+
+  // Sources whose counts came from gcov JSON, which omits lines that are
+  // not executable.
+  std::set<std::string> jsonSourceFiles;
+
   // files is a list of *.da and *.gcda files with coverage data in them.
   // These are binary files that you give as input to gcov so that it will
   // give us text output we can analyze to summarize coverage.
   //
-  for (std::string const& f : files) {
+  for (size_t fileIndex = 0; fileIndex < files.size(); ++fileIndex) {
+    std::string const& f = files[fileIndex];
     cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT, "." << std::flush,
                        this->Quiet);
 
-    // Call gcov to get coverage data for this *.gcda file:
-    //
+    // Collect the results of running gcov for this *.gcda file in order.
+    GCovRun run;
+    {
+      std::unique_lock<std::mutex> lock(runMutex);
+      runDone.wait(lock, [&runs, fileIndex] { return runs[fileIndex].Done; });
+      run = std::move(runs[fileIndex]);
+    }
+
     std::string fileDir = cmSystemTools::GetFilenamePath(f);
-    std::vector<std::string> covargs = basecovargs;
-    covargs.push_back(fileDir);
-    covargs.push_back(f);
-    const std::string command = joinCommandLine(covargs);
+    const std::string command = joinCommandLine(run.Command);
 
     cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
                        command << std::endl, this->Quiet);
 
-    std::string output;
-    std::string errors;
-    int retVal = 0;
+    std::string const& output = run.Output;
+    std::string const& errors = run.Errors;
+    int retVal = run.RetVal;
     *cont->OFS << "* Run coverage for: " << fileDir << std::endl;
     *cont->OFS << "  Command: " << command << std::endl;
-    int res = this->CTest->RunCommand(covargs, &output, &errors, &retVal,
-                                      tempDir.c_str(),
-                                      cmDuration::zero() /*this->TimeOut*/);
+    bool res = run.Res;
 
     *cont->OFS << "  Output: " << output << std::endl;
     *cont->OFS << "  Errors: " << errors << std::endl;
@@ -995,8 +1328,19 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
         << std::endl,
       this->Quiet);
 
+    // A run in gcov JSON intermediate format was already parsed.
+    for (auto const& source : run.Sources) {
+      std::string const actualFile = findActualSourceFile(source.first);
+      if (!actualFile.empty()) {
+        MergeGCovCounts(cont->TotalCoverage[actualFile], source.second);
+        jsonSourceFiles.insert(actualFile);
+      }
+    }
+
     std::vector<std::string> lines;
-    cmsys::SystemTools::Split(output, lines);
+    if (!run.JSON) {
+      cmsys::SystemTools::Split(output, lines);
+    }
 
     for (std::string const& line : lines) {
       std::string sourceFile;
@@ -1138,57 +1482,12 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
                            "   in gcovFile: " << gcovFile << std::endl,
                            this->Quiet);
 
-        cmsys::ifstream ifile(gcovFile.c_str());
-        if (!ifile) {
+        auto counts = run.Counts.find(gcovFile);
+        if (counts == run.Counts.end()) {
           cmCTestLog(this->CTest, ERROR_MESSAGE,
                      "Cannot open file: " << gcovFile << std::endl);
         } else {
-          std::string nl;
-          while (cmSystemTools::GetLineFromStream(ifile, nl)) {
-            // Skip empty lines
-            if (nl.empty()) {
-              continue;
-            }
-
-            // Skip unused lines
-            if (nl.size() < 12) {
-              continue;
-            }
-
-            // Handle gcov 3.0 non-coverage lines
-            // non-coverage lines seem to always start with something not
-            // a space and don't have a ':' in the 9th position
-            // TODO: Verify that this is actually a robust metric
-            if (nl[0] != ' ' && nl[9] != ':') {
-              continue;
-            }
-
-            // Read the coverage count from the beginning of the gcov output
-            // line
-            std::string prefix = nl.substr(0, 12);
-            int cov = atoi(prefix.c_str());
-
-            // Read the line number starting at the 10th character of the gcov
-            // output line
-            std::string lineNumber = nl.substr(10, 5);
-
-            int lineIdx = atoi(lineNumber.c_str()) - 1;
-            if (lineIdx >= 0) {
-              while (vec.size() <= static_cast<size_t>(lineIdx)) {
-                vec.push_back(-1);
-              }
-
-              // Initially all entries are -1 (not used). If we get coverage
-              // information, increment it to 0 first.
-              if (vec[lineIdx] < 0) {
-                if (cov > 0 || prefix.find('#') != std::string::npos) {
-                  vec[lineIdx] = 0;
-                }
-              }
-
-              vec[lineIdx] += cov;
-            }
-          }
+          MergeGCovCounts(vec, counts->second);
         }
 
         actualSourceFile.clear();
@@ -1197,48 +1496,7 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
       if (!sourceFile.empty() && actualSourceFile.empty()) {
         gcovFile.clear();
 
-        // Is it in the source dir or the binary dir?
-        //
-        if (IsFileInDir(sourceFile, cont->SourceDir)) {
-          cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
-                             "   produced s: " << sourceFile << std::endl,
-                             this->Quiet);
-          *cont->OFS << "  produced in source dir: " << sourceFile
-                     << std::endl;
-          actualSourceFile = cmSystemTools::CollapseFullPath(sourceFile);
-        } else if (IsFileInDir(sourceFile, cont->BinaryDir)) {
-          cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
-                             "   produced b: " << sourceFile << std::endl,
-                             this->Quiet);
-          *cont->OFS << "  produced in binary dir: " << sourceFile
-                     << std::endl;
-          actualSourceFile = cmSystemTools::CollapseFullPath(sourceFile);
-        }
-
-        if (actualSourceFile.empty()) {
-          if (missingFiles.find(sourceFile) == missingFiles.end()) {
-            cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
-                               "Something went wrong" << std::endl,
-                               this->Quiet);
-            cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
-                               "Cannot find file: [" << sourceFile << "]"
-                                                     << std::endl,
-                               this->Quiet);
-            cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
-                               " in source dir: [" << cont->SourceDir << "]"
-                                                   << std::endl,
-                               this->Quiet);
-            cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
-                               " or binary dir: [" << cont->BinaryDir.size()
-                                                   << "]" << std::endl,
-                               this->Quiet);
-            *cont->OFS << "  Something went wrong. Cannot find file: "
-                       << sourceFile << " in source dir: " << cont->SourceDir
-                       << " or binary dir: " << cont->BinaryDir << std::endl;
-
-            missingFiles.insert(sourceFile);
-          }
-        }
+        actualSourceFile = findActualSourceFile(sourceFile);
       }
     }
 
@@ -1253,6 +1511,25 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
     }
   }
 
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  // Cover every line of the sources read from JSON, like a .gcov file does.
+  for (std::string const& sourceFile : jsonSourceFiles) {
+    cmsys::ifstream ifs(sourceFile.c_str());
+    size_t lineCount = 0;
+    std::string line;
+    while (cmSystemTools::GetLineFromStream(ifs, line)) {
+      ++lineCount;
+    }
+    cmCTestCoverageHandlerContainer::SingleFileCoverageVector& vec =
+      cont->TotalCoverage[sourceFile];
+    if (vec.size() < lineCount) {
+      vec.resize(lineCount, -1);
+    }
+  }
+
   return file_count;
 }
 
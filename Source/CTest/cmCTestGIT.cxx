@@ -547,7 +547,7 @@ private:
   {
     // Look for header fields that we need.
     if (cmHasLiteralPrefix(this->Line, "commit ")) {
-      this->Rev.Rev = this->Line.substr(7);
+      this->Rev.Rev.assign(this->Line, 7, std::string::npos);
     } else if (cmHasLiteralPrefix(this->Line, "author ")) {
       Person author;
       this->ParsePerson(this->Line.c_str() + 7, author);
@@ -567,7 +567,7 @@ private:
   {
     // Commit log lines are indented by 4 spaces.
     if (this->Line.size() >= 4) {
-      this->Rev.Log += this->Line.substr(4);
+      this->Rev.Log.append(this->Line, 4, std::string::npos);
     }
     this->Rev.Log += "\n";
   }
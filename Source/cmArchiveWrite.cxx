@@ -2,16 +2,22 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmArchiveWrite.h"
 
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <deque>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include <cm/algorithm>
+#include <cm/memory>
 
 #include <cm3p/archive.h>
 #include <cm3p/archive_entry.h>
@@ -71,19 +77,277 @@ public:
   operator struct archive_entry *() { return this->Object; }
 };
 
+/** Compress the archive data in independent blocks on worker threads.
+ *
+ * The data written by libarchive are collected into blocks that are
+ * queued for compression.  Each block is compressed by its own libarchive
+ * "raw" writer into a complete gzip member or bzip2 stream, and finished
+ * blocks are written to the output in order.  The number of blocks in
+ * flight is bounded so that reading the input overlaps with compression
+ * without buffering the whole archive.
+ */
+class cmArchiveWrite::ParallelCompressor
+{
+public:
+  ParallelCompressor(std::ostream& os, Compress c, int compressionLevel,
+                     int numThreads);
+  ~ParallelCompressor();
+
+  ParallelCompressor(const ParallelCompressor&) = delete;
+  ParallelCompressor& operator=(const ParallelCompressor&) = delete;
+
+  bool Write(const char* data, size_t n);
+  bool Finish();
+
+  std::string const& GetError() const { return this->Error; }
+
+private:
+  struct Block
+  {
+    std::string Input;
+    std::string Output;
+    std::string Error;
+    bool Done = false;
+  };
+
+  bool Submit();
+  bool WriteFinishedBlocks(size_t maxPending);
+  void Work();
+  void CompressBlock(Block& block) const;
+
+  static __LA_SSIZE_T Append(struct archive* /*unused*/, void* cd,
+                             const void* b, size_t n)
+  {
+    static_cast<std::string*>(cd)->append(static_cast<const char*>(b), n);
+    return static_cast<__LA_SSIZE_T>(n);
+  }
+
+  std::ostream& Stream;
+  cmArchiveWrite::Compress Method;
+  std::string CompressionLevel;
+  size_t BlockSize;
+  size_t MaxPending;
+  std::string Current;
+  bool Submitted = false;
+  std::string Error;
+
+  std::mutex Mutex;
+  std::condition_variable WorkAvailable;
+  std::condition_variable WorkDone;
+  // Blocks not yet written, in output order.
+  std::deque<std::unique_ptr<Block>> Pending;
+  // Blocks not yet compressed.
+  std::deque<Block*> Queue;
+  bool Stopping = false;
+  std::vector<std::thread> Threads;
+};
+
+cmArchiveWrite::ParallelCompressor::ParallelCompressor(std::ostream& os,
+                                                       Compress c,
+                                                       int compressionLevel,
+                                                       int numThreads)
+  : Stream(os)
+  , Method(c)
+  , MaxPending(2 * static_cast<size_t>(numThreads))
+{
+  if (compressionLevel != 0) {
+    this->CompressionLevel = std::to_string(compressionLevel);
+  }
+  if (c == CompressBZip2) {
+    // Match one bzip2 block of the selected level.
+    this->BlockSize = 100000 * (compressionLevel != 0 ? compressionLevel : 9);
+  } else {
+    this->BlockSize = 1024 * 1024;
+  }
+  this->Threads.reserve(numThreads);
+  for (int i = 0; i < numThreads; ++i) {
+    this->Threads.emplace_back([this]() { this->Work(); });
+  }
+}
+
+cmArchiveWrite::ParallelCompressor::~ParallelCompressor()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Queue.clear();
+    this->Stopping = true;
+  }
+  this->WorkAvailable.notify_all();
+  for (std::thread& thread : this->Threads) {
+    thread.join();
+  }
+}
+
+bool cmArchiveWrite::ParallelCompressor::Write(const char* data, size_t n)
+{
+  this->Current.append(data, n);
+  if (this->Current.size() >= this->BlockSize) {
+    return this->Submit();
+  }
+  return true;
+}
+
+bool cmArchiveWrite::ParallelCompressor::Finish()
+{
+  // Always produce at least one member so an empty archive is valid.
+  if (!this->Current.empty() || !this->Submitted) {
+    if (!this->Submit()) {
+      return false;
+    }
+  }
+  return this->WriteFinishedBlocks(0);
+}
+
+bool cmArchiveWrite::ParallelCompressor::Submit()
+{
+  auto block = cm::make_unique<Block>();
+  block->Input = std::move(this->Current);
+  this->Current.clear();
+  this->Submitted = true;
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Queue.push_back(block.get());
+    this->Pending.push_back(std::move(block));
+  }
+  this->WorkAvailable.notify_one();
+  return this->WriteFinishedBlocks(this->MaxPending);
+}
+
+bool cmArchiveWrite::ParallelCompressor::WriteFinishedBlocks(
+  size_t maxPending)
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  while (!this->Pending.empty()) {
+    if (!this->Pending.front()->Done) {
+      if (this->Pending.size() <= maxPending) {
+        break;
+      }
+      this->WorkDone.wait(lock);
+      continue;
+    }
+    std::unique_ptr<Block> block = std::move(this->Pending.front());
+    this->Pending.pop_front();
+    lock.unlock();
+    if (!block->Error.empty()) {
+      this->Error = std::move(block->Error);
+      return false;
+    }
+    std::streamsize const size =
+      static_cast<std::streamsize>(block->Output.size());
+    if (!this->Stream.write(block->Output.data(), size)) {
+      this->Error = cmStrCat("Error writing compressed data: ",
+                             cmSystemTools::GetLastSystemError());
+      return false;
+    }
+    lock.lock();
+  }
+  return true;
+}
+
+void cmArchiveWrite::ParallelCompressor::Work()
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  for (;;) {
+    this->WorkAvailable.wait(
+      lock, [this]() { return this->Stopping || !this->Queue.empty(); });
+    if (this->Queue.empty()) {
+      return;
+    }
+    Block* block = this->Queue.front();
+    this->Queue.pop_front();
+    lock.unlock();
+    this->CompressBlock(*block);
+    lock.lock();
+    block->Done = true;
+    this->WorkDone.notify_all();
+  }
+}
+
+void cmArchiveWrite::ParallelCompressor::CompressBlock(Block& block) const
+{
+  struct archive* a = archive_write_new();
+  char const* filterName = nullptr;
+  int status;
+  if (this->Method == CompressBZip2) {
+    filterName = "bzip2";
+    status = archive_write_add_filter_bzip2(a);
+  } else {
+    filterName = "gzip";
+    status = archive_write_add_filter_gzip(a);
+    // Block timestamps would make the output depend on when it was made.
+    if (status == ARCHIVE_OK) {
+      status =
+        archive_write_set_filter_option(a, "gzip", "timestamp", nullptr);
+    }
+  }
+  if (status == ARCHIVE_OK && !this->CompressionLevel.empty()) {
+    status = archive_write_set_filter_option(
+      a, filterName, "compression-level", this->CompressionLevel.c_str());
+  }
+  if (status == ARCHIVE_OK) {
+    status = archive_write_set_format_raw(a);
+  }
+  if (status == ARCHIVE_OK) {
+    status = archive_write_set_bytes_in_last_block(a, 1);
+  }
+  if (status == ARCHIVE_OK) {
+    status = archive_write_open(
+      a, &block.Output, nullptr,
+      reinterpret_cast<archive_write_callback*>(&Append), nullptr);
+  }
+  if (status == ARCHIVE_OK) {
+    Entry e;
+    archive_entry_set_filetype(e, AE_IFREG);
+    archive_entry_set_size(e, static_cast<la_int64_t>(block.Input.size()));
+    status = archive_write_header(a, e);
+  }
+  if (status == ARCHIVE_OK && !block.Input.empty() &&
+      archive_write_data(a, block.Input.data(), block.Input.size()) !=
+        static_cast<__LA_SSIZE_T>(block.Input.size())) {
+    status = ARCHIVE_FATAL;
+  }
+  if (status == ARCHIVE_OK) {
+    status = archive_write_close(a);
+  }
+  if (status != ARCHIVE_OK) {
+    block.Error = cmStrCat("Error compressing archive block: ",
+                           cm_archive_error_string(a));
+  }
+  archive_write_free(a);
+  std::string().swap(block.Input);
+}
+
 struct cmArchiveWrite::Callback
 {
   // archive_write_callback
-  static __LA_SSIZE_T Write(struct archive* /*unused*/, void* cd,
-                            const void* b, size_t n)
+  static __LA_SSIZE_T Write(struct archive* a, void* cd, const void* b,
+                            size_t n)
   {
     cmArchiveWrite* self = static_cast<cmArchiveWrite*>(cd);
+    if (self->Parallel) {
+      if (self->Parallel->Write(static_cast<const char*>(b), n)) {
+        return static_cast<__LA_SSIZE_T>(n);
+      }
+      archive_set_error(a, -1, "%s", self->Parallel->GetError().c_str());
+      return static_cast<__LA_SSIZE_T>(-1);
+    }
     if (self->Stream.write(static_cast<const char*>(b),
                            static_cast<std::streamsize>(n))) {
       return static_cast<__LA_SSIZE_T>(n);
     }
     return static_cast<__LA_SSIZE_T>(-1);
   }
+
+  // archive_close_callback
+  static int Close(struct archive* a, void* cd)
+  {
+    cmArchiveWrite* self = static_cast<cmArchiveWrite*>(cd);
+    if (self->Parallel && !self->Parallel->Finish()) {
+      archive_set_error(a, -1, "%s", self->Parallel->GetError().c_str());
+      return ARCHIVE_FATAL;
+    }
+    return ARCHIVE_OK;
+  }
 };
 
 cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c,
@@ -107,6 +371,14 @@ cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c,
 
   std::string sNumThreads = std::to_string(numThreads);
 
+  // libarchive compresses gzip and bzip2 on a single thread.
+  // Compress independent blocks concurrently instead.
+  if (numThreads > 1 && (c == CompressGZip || c == CompressBZip2)) {
+    this->Parallel = cm::make_unique<ParallelCompressor>(
+      os, c, compressionLevel, numThreads);
+    c = CompressNone;
+  }
+
   switch (c) {
     case CompressNone:
       if (archive_write_add_filter_none(this->Archive) != ARCHIVE_OK) {
@@ -264,7 +536,8 @@ bool cmArchiveWrite::Open()
   if (archive_write_open(
         this->Archive, this, nullptr,
         reinterpret_cast<archive_write_callback*>(&Callback::Write),
-        nullptr) != ARCHIVE_OK) {
+        reinterpret_cast<archive_close_callback*>(&Callback::Close)) !=
+      ARCHIVE_OK) {
     this->Error =
       cmStrCat("archive_write_open: ", cm_archive_error_string(this->Archive));
     return false;
@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <iosfwd>
+#include <memory>
 #include <string>
 
 #if defined(CMAKE_BOOTSTRAP)
@@ -52,7 +53,13 @@ public:
     CompressZstd
   };
 
-  /** Construct with output stream to which to write archive.  */
+  /** Construct with output stream to which to write archive.
+   *
+   * With more than one thread, gzip and bzip2 compression is done by
+   * splitting the archive into independent blocks that are compressed
+   * concurrently and written as consecutive gzip members or bzip2
+   * streams.  Standard decompressors read them as a single stream.
+   */
   cmArchiveWrite(std::ostream& os, Compress c = CompressNone,
                  std::string const& format = "paxr", int compressionLevel = 0,
                  int numThreads = 1);
@@ -152,8 +159,10 @@ private:
   friend struct Callback;
 
   class Entry;
+  class ParallelCompressor;
 
   std::ostream& Stream;
+  std::unique_ptr<ParallelCompressor> Parallel;
   struct archive* Archive;
   struct archive* Disk;
   bool Verbose = false;
@@ -0,0 +1,62 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+
+#include "cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool.h"
+
+#include "cmELF.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool::
+  cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool(
+    cmRuntimeDependencyArchive* archive)
+  : cmBinUtilsLinuxELFGetRuntimeDependenciesTool(archive)
+{
+}
+
+bool cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool::GetFileInfo(
+  std::string const& file, std::vector<std::string>& needed,
+  std::vector<std::string>& rpaths, std::vector<std::string>& runpaths)
+{
+  std::string error;
+  if (!ReadFileInfo(file, needed, rpaths, runpaths, error)) {
+    this->SetError(error);
+    return false;
+  }
+  return true;
+}
+
+bool cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool::ReadFileInfo(
+  std::string const& file, std::vector<std::string>& needed,
+  std::vector<std::string>& rpaths, std::vector<std::string>& runpaths,
+  std::string& error)
+{
+  cmELF elf(file.c_str());
+  if (!elf) {
+    error = cmStrCat("Failed to parse ELF file:\n  ", file, "\n",
+                     elf.GetErrorMessage());
+    return false;
+  }
+
+  needed = elf.GetNeeded();
+  if (cmELF::StringEntry const* se = elf.GetRPath()) {
+    for (std::string const& rpath :
+         cmSystemTools::SplitString(se->Value, ':')) {
+      rpaths.push_back(rpath);
+    }
+  }
+  if (cmELF::StringEntry const* se = elf.GetRunPath()) {
+    for (std::string const& runpath :
+         cmSystemTools::SplitString(se->Value, ':')) {
+      runpaths.push_back(runpath);
+    }
+  }
+
+  // Reading any of the dynamic entries may have invalidated the file.
+  if (!elf) {
+    error = cmStrCat("Failed to read dynamic section of ELF file:\n  ", file,
+                     "\n", elf.GetErrorMessage());
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,36 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cmBinUtilsLinuxELFGetRuntimeDependenciesTool.h"
+
+class cmRuntimeDependencyArchive;
+
+/** \class cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool
+ * \brief Read DT_NEEDED, DT_RPATH and DT_RUNPATH entries with cmELF.
+ *
+ * Unlike the objdump tool, this does not spawn a process per file.
+ */
+class cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool
+  : public cmBinUtilsLinuxELFGetRuntimeDependenciesTool
+{
+public:
+  cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool(
+    cmRuntimeDependencyArchive* archive);
+
+  bool GetFileInfo(std::string const& file, std::vector<std::string>& needed,
+                   std::vector<std::string>& rpaths,
+                   std::vector<std::string>& runpaths) override;
+
+  /** Read the dependency information of a file without reporting errors
+      to the archive.  This may be called concurrently.  */
+  static bool ReadFileInfo(std::string const& file,
+                           std::vector<std::string>& needed,
+                           std::vector<std::string>& rpaths,
+                           std::vector<std::string>& runpaths,
+                           std::string& error);
+};
@@ -3,18 +3,27 @@
 
 #include "cmBinUtilsLinuxELFLinker.h"
 
-#include <queue>
+#include <algorithm>
+#include <cstddef>
+#include <deque>
 #include <sstream>
 #include <unordered_set>
 #include <utility>
 
+#ifndef CMAKE_BOOTSTRAP
+#  include <atomic>
+#  include <thread>
+#endif
+
 #include <cm/memory>
 #include <cm/string_view>
 
 #include <cmsys/RegularExpression.hxx>
 
+#include "cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool.h"
 #include "cmBinUtilsLinuxELFObjdumpGetRuntimeDependenciesTool.h"
 #include "cmELF.h"
+#include "cmLDConfigBuiltinTool.h"
 #include "cmLDConfigLDConfigTool.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
@@ -61,6 +70,11 @@ bool cmBinUtilsLinuxELFLinker::Prepare()
     this->Tool =
       cm::make_unique<cmBinUtilsLinuxELFObjdumpGetRuntimeDependenciesTool>(
         this->Archive);
+  } else if (tool == "builtin") {
+    this->Tool =
+      cm::make_unique<cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool>(
+        this->Archive);
+    this->ToolIsBuiltin = true;
   } else {
     std::ostringstream e;
     e << "Invalid value for CMAKE_GET_RUNTIME_DEPENDENCIES_TOOL: " << tool;
@@ -71,7 +85,7 @@ bool cmBinUtilsLinuxELFLinker::Prepare()
   std::string ldConfigTool =
     this->Archive->GetMakefile()->GetSafeDefinition("CMAKE_LDCONFIG_TOOL");
   if (ldConfigTool.empty()) {
-    ldConfigTool = "ldconfig";
+    ldConfigTool = this->ToolIsBuiltin ? "builtin" : "ldconfig";
   }
   if (ldConfigTool == "ldconfig") {
     this->LDConfigTool =
@@ -79,6 +93,13 @@ bool cmBinUtilsLinuxELFLinker::Prepare()
     if (!this->LDConfigTool->GetLDConfigPaths(this->LDConfigPaths)) {
       return false;
     }
+  } else if (ldConfigTool == "builtin") {
+    auto builtinTool = cm::make_unique<cmLDConfigBuiltinTool>(this->Archive);
+    if (!builtinTool->GetLDConfigPaths(this->LDConfigPaths)) {
+      return false;
+    }
+    this->LDConfigLibraries = builtinTool->GetLibraries();
+    this->LDConfigTool = std::move(builtinTool);
   } else {
     std::ostringstream e;
     e << "Invalid value for CMAKE_LDCONFIG_TOOL: " << ldConfigTool;
@@ -113,22 +134,35 @@ bool cmBinUtilsLinuxELFLinker::ScanDependencies(
 bool cmBinUtilsLinuxELFLinker::ScanDependencies(std::string const& mainFile)
 {
   std::unordered_set<std::string> resolvedDependencies;
-  std::queue<std::pair<std::string, std::vector<std::string>>> queueToResolve;
-  queueToResolve.push(std::make_pair(mainFile, std::vector<std::string>{}));
+  std::deque<std::pair<std::string, std::vector<std::string>>> queueToResolve;
+  queueToResolve.emplace_back(mainFile, std::vector<std::string>{});
 
   while (!queueToResolve.empty()) {
+    // Read all queued files at once so they may be parsed concurrently.
+    if (this->ToolIsBuiltin &&
+        this->FileInfoCache.count(queueToResolve.front().first) == 0) {
+      std::vector<std::string> files;
+      for (auto const& entry : queueToResolve) {
+        if (this->FileInfoCache.count(entry.first) == 0) {
+          files.push_back(entry.first);
+        }
+      }
+      this->PrefetchFileInfo(files);
+    }
+
     std::string file = std::move(queueToResolve.front().first);
     std::vector<std::string> parentRpaths =
       std::move(queueToResolve.front().second);
-    queueToResolve.pop();
+    queueToResolve.pop_front();
 
-    std::string origin = cmSystemTools::GetFilenamePath(file);
-    std::vector<std::string> needed;
-    std::vector<std::string> rpaths;
-    std::vector<std::string> runpaths;
-    if (!this->Tool->GetFileInfo(file, needed, rpaths, runpaths)) {
+    FileInfo const* info = this->GetFileInfo(file);
+    if (!info) {
       return false;
     }
+    std::string origin = cmSystemTools::GetFilenamePath(file);
+    std::vector<std::string> const& needed = info->Needed;
+    std::vector<std::string> rpaths = info->RPaths;
+    std::vector<std::string> runpaths = info->RunPaths;
     for (auto& runpath : runpaths) {
       runpath = ReplaceOrigin(runpath, origin);
     }
@@ -145,9 +179,6 @@ bool cmBinUtilsLinuxELFLinker::ScanDependencies(std::string const& mainFile)
                          parentRpaths.end());
     }
 
-    searchPaths.insert(searchPaths.end(), this->LDConfigPaths.begin(),
-                       this->LDConfigPaths.end());
-
     for (auto const& dep : needed) {
       if (resolvedDependencies.count(dep) != 0 ||
           this->Archive->IsPreExcluded(dep)) {
@@ -173,7 +204,7 @@ bool cmBinUtilsLinuxELFLinker::ScanDependencies(std::string const& mainFile)
             combinedParentRpaths.insert(combinedParentRpaths.end(),
                                         rpaths.begin(), rpaths.end());
 
-            queueToResolve.push(std::make_pair(path, combinedParentRpaths));
+            queueToResolve.emplace_back(path, combinedParentRpaths);
           }
         }
       } else {
@@ -185,15 +216,83 @@ bool cmBinUtilsLinuxELFLinker::ScanDependencies(std::string const& mainFile)
   return true;
 }
 
-namespace {
-bool FileHasArchitecture(const char* filename, std::uint16_t machine)
+cmBinUtilsLinuxELFLinker::FileInfo const*
+cmBinUtilsLinuxELFLinker::GetFileInfo(std::string const& file)
 {
-  cmELF elf(filename);
-  if (!elf) {
-    return false;
+  auto it = this->FileInfoCache.find(file);
+  if (it == this->FileInfoCache.end()) {
+    FileInfo info;
+    if (!this->Tool->GetFileInfo(file, info.Needed, info.RPaths,
+                                 info.RunPaths)) {
+      return nullptr;
+    }
+    info.Valid = true;
+    it = this->FileInfoCache.emplace(file, std::move(info)).first;
+  }
+  if (!it->second.Valid) {
+    this->SetError(it->second.Error);
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void cmBinUtilsLinuxELFLinker::PrefetchFileInfo(
+  std::vector<std::string> const& files)
+{
+  std::vector<FileInfo> infos(files.size());
+  auto read = [&files, &infos](std::size_t i) {
+    FileInfo& info = infos[i];
+    info.Valid =
+      cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool::ReadFileInfo(
+        files[i], info.Needed, info.RPaths, info.RunPaths, info.Error);
+  };
+
+#ifndef CMAKE_BOOTSTRAP
+  std::size_t const numThreads = std::min<std::size_t>(
+    std::thread::hardware_concurrency(), files.size());
+  if (numThreads > 1) {
+    std::atomic<std::size_t> next(0);
+    auto worker = [&files, &next, &read]() {
+      for (std::size_t i = next++; i < files.size(); i = next++) {
+        read(i);
+      }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (std::size_t t = 0; t < numThreads; ++t) {
+      threads.emplace_back(worker);
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  } else
+#endif
+  {
+    for (std::size_t i = 0; i < files.size(); ++i) {
+      read(i);
+    }
+  }
+
+  for (std::size_t i = 0; i < files.size(); ++i) {
+    this->FileInfoCache.emplace(files[i], std::move(infos[i]));
   }
-  return machine == 0 || machine == elf.GetMachine();
 }
+
+bool cmBinUtilsLinuxELFLinker::FileHasArchitecture(std::string const& path)
+{
+  auto it = this->FileMachineCache.find(path);
+  if (it == this->FileMachineCache.end()) {
+    int machine = -1;
+    if (cmSystemTools::PathExists(path)) {
+      cmELF elf(path.c_str());
+      if (elf) {
+        machine = elf.GetMachine();
+      }
+    }
+    it = this->FileMachineCache.emplace(path, machine).first;
+  }
+  return it->second >= 0 &&
+    (this->Machine == 0 || this->Machine == it->second);
 }
 
 bool cmBinUtilsLinuxELFLinker::ResolveDependency(
@@ -202,8 +301,28 @@ bool cmBinUtilsLinuxELFLinker::ResolveDependency(
 {
   for (auto const& searchPath : searchPaths) {
     path = cmStrCat(searchPath, '/', name);
-    if (cmSystemTools::PathExists(path) &&
-        FileHasArchitecture(path.c_str(), this->Machine)) {
+    if (this->FileHasArchitecture(path)) {
+      resolved = true;
+      return true;
+    }
+  }
+
+  // Like the dynamic loader, use the path the ldconfig cache records for
+  // this soname before searching the directories the cache mentions.
+  auto lib = this->LDConfigLibraries.find(name);
+  if (lib != this->LDConfigLibraries.end()) {
+    for (auto const& libPath : lib->second) {
+      if (this->FileHasArchitecture(libPath)) {
+        path = libPath;
+        resolved = true;
+        return true;
+      }
+    }
+  }
+
+  for (auto const& searchPath : this->LDConfigPaths) {
+    path = cmStrCat(searchPath, '/', name);
+    if (this->FileHasArchitecture(path)) {
       resolved = true;
       return true;
     }
@@ -211,8 +330,7 @@ bool cmBinUtilsLinuxELFLinker::ResolveDependency(
 
   for (auto const& searchPath : this->Archive->GetSearchDirectories()) {
     path = cmStrCat(searchPath, '/', name);
-    if (cmSystemTools::PathExists(path) &&
-        FileHasArchitecture(path.c_str(), this->Machine)) {
+    if (this->FileHasArchitecture(path)) {
       std::ostringstream warning;
       warning << "Dependency " << name << " found in search directory:\n  "
               << searchPath
@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "cmBinUtilsLinker.h"
@@ -28,14 +29,41 @@ public:
                         cmStateEnums::TargetType type) override;
 
 private:
+  struct FileInfo
+  {
+    bool Valid = false;
+    std::string Error;
+    std::vector<std::string> Needed;
+    std::vector<std::string> RPaths;
+    std::vector<std::string> RunPaths;
+  };
+
   std::unique_ptr<cmBinUtilsLinuxELFGetRuntimeDependenciesTool> Tool;
+  bool ToolIsBuiltin = false;
   std::unique_ptr<cmLDConfigTool> LDConfigTool;
   bool HaveLDConfigPaths = false;
   std::vector<std::string> LDConfigPaths;
+
+  // Paths recorded for each soname by the ldconfig cache, if read.
+  std::unordered_map<std::string, std::vector<std::string>> LDConfigLibraries;
   std::uint16_t Machine = 0;
 
+  // Dependency information of every file read so far, shared by all
+  // the files scanned with this linker.
+  std::unordered_map<std::string, FileInfo> FileInfoCache;
+
+  // Machine of every candidate file checked so far, or -1 if the file
+  // does not exist or is not an ELF file.
+  std::unordered_map<std::string, int> FileMachineCache;
+
   bool ScanDependencies(std::string const& mainFile);
 
+  FileInfo const* GetFileInfo(std::string const& file);
+
+  void PrefetchFileInfo(std::vector<std::string> const& files);
+
+  bool FileHasArchitecture(std::string const& path);
+
   bool ResolveDependency(std::string const& name,
                          std::vector<std::string> const& searchPaths,
                          std::string& path, bool& resolved);
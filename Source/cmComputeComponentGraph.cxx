@@ -51,6 +51,58 @@ void cmComputeComponentGraph::Tarjan()
 }
 
 void cmComputeComponentGraph::TarjanVisit(size_t i)
+{
+  // Walk the graph depth-first with an explicit stack so that deep
+  // dependency chains cannot overflow the native call stack.  Each
+  // frame records the node and the next outgoing edge to follow.
+  std::vector<TarjanFrame> frames;
+  this->TarjanEnter(i);
+  frames.push_back({ i, 0 });
+
+  while (!frames.empty()) {
+    TarjanFrame& frame = frames.back();
+    size_t const node = frame.Node;
+
+    // Follow outgoing edges.
+    EdgeList const& nl = this->InputGraph[node];
+    if (frame.Edge < nl.size()) {
+      size_t j = nl[frame.Edge];
+
+      // Visit the destination if it has not yet been visited.  The
+      // edge is revisited once the destination has been completed.
+      if (!this->TarjanVisited[j]) {
+        this->TarjanEnter(j);
+        frames.push_back({ j, 0 });
+        continue;
+      }
+      ++frame.Edge;
+
+      // Ignore edges to nodes that have been reached by a previous DFS
+      // walk.  Since we did not reach the current node from that walk
+      // it must not belong to the same component and it has already
+      // been assigned to a component.
+      if (this->TarjanVisited[j] < this->TarjanWalkId) {
+        continue;
+      }
+
+      this->TarjanUpdateRoot(node, j);
+      continue;
+    }
+
+    // All edges have been followed.
+    this->TarjanLeave(node);
+    frames.pop_back();
+
+    // Resume the edge of the parent that led to this node.
+    if (!frames.empty()) {
+      TarjanFrame& parent = frames.back();
+      this->TarjanUpdateRoot(parent.Node, node);
+      ++parent.Edge;
+    }
+  }
+}
+
+void cmComputeComponentGraph::TarjanEnter(size_t i)
 {
   // We are now visiting this node.
   this->TarjanVisited[i] = this->TarjanWalkId;
@@ -60,36 +112,22 @@ void cmComputeComponentGraph::TarjanVisit(size_t i)
   this->TarjanComponents[i] = INVALID_COMPONENT;
   this->TarjanEntries[i].VisitIndex = ++this->TarjanIndex;
   this->TarjanStack.push(i);
+}
 
-  // Follow outgoing edges.
-  EdgeList const& nl = this->InputGraph[i];
-  for (cmGraphEdge const& ni : nl) {
-    size_t j = ni;
-
-    // Ignore edges to nodes that have been reached by a previous DFS
-    // walk.  Since we did not reach the current node from that walk
-    // it must not belong to the same component and it has already
-    // been assigned to a component.
-    if (this->TarjanVisited[j] > 0 &&
-        this->TarjanVisited[j] < this->TarjanWalkId) {
-      continue;
-    }
-
-    // Visit the destination if it has not yet been visited.
-    if (!this->TarjanVisited[j]) {
-      this->TarjanVisit(j);
-    }
-
-    // If the destination has not yet been assigned to a component,
-    // check if it has a better root for the current object.
-    if (this->TarjanComponents[j] == INVALID_COMPONENT) {
-      if (this->TarjanEntries[this->TarjanEntries[j].Root].VisitIndex <
-          this->TarjanEntries[this->TarjanEntries[i].Root].VisitIndex) {
-        this->TarjanEntries[i].Root = this->TarjanEntries[j].Root;
-      }
+void cmComputeComponentGraph::TarjanUpdateRoot(size_t i, size_t j)
+{
+  // If the destination has not yet been assigned to a component,
+  // check if it has a better root for the current object.
+  if (this->TarjanComponents[j] == INVALID_COMPONENT) {
+    if (this->TarjanEntries[this->TarjanEntries[j].Root].VisitIndex <
+        this->TarjanEntries[this->TarjanEntries[i].Root].VisitIndex) {
+      this->TarjanEntries[i].Root = this->TarjanEntries[j].Root;
     }
   }
+}
 
+void cmComputeComponentGraph::TarjanLeave(size_t i)
+{
   // Check if we have found a component.
   if (this->TarjanEntries[i].Root == i) {
     // Yes.  Create it.
@@ -75,8 +75,16 @@ private:
   std::stack<size_t> TarjanStack;
   size_t TarjanWalkId;
   size_t TarjanIndex;
+  struct TarjanFrame
+  {
+    size_t Node;
+    size_t Edge;
+  };
   void Tarjan();
   void TarjanVisit(size_t i);
+  void TarjanEnter(size_t i);
+  void TarjanUpdateRoot(size_t i, size_t j);
+  void TarjanLeave(size_t i);
 
   // Connected components.
 };
@@ -5,8 +5,8 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
-#include <iterator>
 #include <sstream>
 #include <type_traits>
 #include <unordered_map>
@@ -720,6 +720,11 @@ void cmComputeLinkDepends::SetOldLinkDirMode(bool b)
 std::vector<cmComputeLinkDepends::LinkEntry> const&
 cmComputeLinkDepends::Compute()
 {
+#ifndef CMAKE_BOOTSTRAP
+  auto profilingRAII = this->CMakeInstance->CreateProfilingEntry(
+    "link_depends", this->Target->GetName());
+#endif
+
   // Follow the link dependencies of the target to be linked.
   this->AddDirectLinkEntries();
 
@@ -1389,21 +1394,52 @@ void cmComputeLinkDepends::InferDependencies()
     // Intersect the sets for this item.
     DependSet common = sets.front();
     for (DependSet const& i : cmMakeRange(sets).advance(1)) {
-      DependSet intersection;
-      std::set_intersection(common.begin(), common.end(), i.begin(), i.end(),
-                            std::inserter(intersection, intersection.begin()));
-      common = intersection;
+      common.IntersectWith(i);
     }
 
     // Add the inferred dependencies to the graph.
+    std::vector<size_t> const indices = common.GetIndices();
     cmGraphEdgeList& edges = this->EntryConstraintGraph[depender_index];
-    edges.reserve(edges.size() + common.size());
-    for (auto const& c : common) {
+    edges.reserve(edges.size() + indices.size());
+    for (size_t c : indices) {
       edges.emplace_back(c, true, false, cmListFileBacktrace());
     }
   }
 }
 
+void cmComputeLinkDepends::DependSet::insert(size_t index)
+{
+  size_t const word = index / 64;
+  if (word >= this->Words.size()) {
+    this->Words.resize(word + 1, 0);
+  }
+  this->Words[word] |= std::uint64_t(1) << (index % 64);
+}
+
+void cmComputeLinkDepends::DependSet::IntersectWith(DependSet const& other)
+{
+  if (this->Words.size() > other.Words.size()) {
+    this->Words.resize(other.Words.size());
+  }
+  for (size_t i = 0; i < this->Words.size(); ++i) {
+    this->Words[i] &= other.Words[i];
+  }
+}
+
+std::vector<size_t> cmComputeLinkDepends::DependSet::GetIndices() const
+{
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < this->Words.size(); ++i) {
+    std::uint64_t bits = this->Words[i];
+    for (size_t b = 0; bits; ++b, bits >>= 1) {
+      if (bits & 1) {
+        indices.push_back(i * 64 + b);
+      }
+    }
+  }
+  return indices;
+}
+
 void cmComputeLinkDepends::UpdateGroupDependencies()
 {
   if (this->GroupItems.empty()) {
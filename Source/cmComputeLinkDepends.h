@@ -5,6 +5,7 @@
 #include "cmConfigure.h" // IWYU pragma: keep
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <queue>
@@ -157,9 +158,18 @@ private:
                                std::vector<cmLinkItem> const& deps);
   void HandleSharedDependency(SharedDepEntry const& dep);
 
-  // Dependency inferral for each link item.
-  struct DependSet : public std::set<size_t>
+  // Dependency inferral for each link item.  The sets are stored as
+  // bitsets indexed by entry so that intersecting them stays cheap for
+  // long link lines.
+  class DependSet
   {
+  public:
+    void insert(size_t index);
+    void IntersectWith(DependSet const& other);
+    std::vector<size_t> GetIndices() const;
+
+  private:
+    std::vector<std::uint64_t> Words;
   };
   struct DependSetList : public std::vector<DependSet>
   {
@@ -205,6 +205,12 @@ void cmComputeTargetDepends::CollectTargetDepends(size_t depender_index)
     return;
   }
 
+#ifndef CMAKE_BOOTSTRAP
+  auto profilingRAII =
+    this->GlobalGenerator->GetCMakeInstance()->CreateProfilingEntry(
+      "target_depends", depender->GetName());
+#endif
+
   // Loop over all targets linked directly in all configs.
   // We need to make targets depend on the union of all config-specific
   // dependencies in all targets, because the generated build-systems can't
@@ -212,13 +218,13 @@ void cmComputeTargetDepends::CollectTargetDepends(size_t depender_index)
   {
     std::set<cmLinkItem> emitted;
 
+    // A target should not depend on itself.
+    emitted.insert(cmLinkItem(depender, false, cmListFileBacktrace()));
+    emitted.insert(cmLinkItem(depender, true, cmListFileBacktrace()));
+
     std::vector<std::string> const& configs =
       depender->Makefile->GetGeneratorConfigs(cmMakefile::IncludeEmptyConfig);
     for (std::string const& it : configs) {
-      // A target should not depend on itself.
-      emitted.insert(cmLinkItem(depender, false, cmListFileBacktrace()));
-      emitted.insert(cmLinkItem(depender, true, cmListFileBacktrace()));
-
       if (cmLinkImplementation const* impl = depender->GetLinkImplementation(
             it, cmGeneratorTarget::UseTo::Link)) {
         for (cmLinkImplItem const& lib : impl->Libraries) {
@@ -294,7 +300,6 @@ void cmComputeTargetDepends::AddInterfaceDepends(
   size_t depender_index, cmLinkItem const& dependee_name,
   const std::string& config, std::set<cmLinkItem>& emitted)
 {
-  cmGeneratorTarget const* depender = this->Targets[depender_index];
   cmGeneratorTarget const* dependee = dependee_name.Target;
   // Skip targets that will not really be linked.  This is probably a
   // name conflict between an external library and an executable
@@ -305,9 +310,8 @@ void cmComputeTargetDepends::AddInterfaceDepends(
   }
 
   if (dependee) {
-    // A target should not depend on itself.
-    emitted.insert(cmLinkItem(depender, false, cmListFileBacktrace()));
-    emitted.insert(cmLinkItem(depender, true, cmListFileBacktrace()));
+    // The depender itself is already in the emitted set so that a
+    // target never depends on itself.
     this->AddInterfaceDepends(depender_index, dependee,
                               dependee_name.Backtrace, config, emitted);
   }
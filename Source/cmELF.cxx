@@ -4,9 +4,11 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <istream>
 #include <map>
 #include <memory>
 #include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -17,6 +19,8 @@
 
 #include "cmsys/FStream.hxx"
 
+#include "cmStringAlgorithms.h"
+
 #include "cmelf/elf32.h"
 #include "cmelf/elf64.h"
 #include "cmelf/elf_common.h"
@@ -109,6 +113,8 @@ public:
   virtual std::vector<char> EncodeDynamicEntries(
     const cmELF::DynamicEntryList&) = 0;
   virtual StringEntry const* GetDynamicSectionString(unsigned int tag) = 0;
+  virtual std::vector<std::string> GetDynamicSectionStrings(
+    unsigned int tag) = 0;
   virtual bool IsMips() const = 0;
   virtual void PrintInfo(std::ostream& os) const = 0;
 
@@ -133,6 +139,12 @@ public:
     return this->GetDynamicSectionString(DT_RUNPATH);
   }
 
+  // Lookup all NEEDED entries in the DYNAMIC section.
+  std::vector<std::string> GetNeeded()
+  {
+    return this->GetDynamicSectionStrings(DT_NEEDED);
+  }
+
   // Return the recorded ELF type.
   cmELF::FileType GetFileType() const { return this->ELFType; }
 
@@ -229,6 +241,10 @@ public:
   // Lookup a string from the dynamic section with the given tag.
   StringEntry const* GetDynamicSectionString(unsigned int tag) override;
 
+  // Lookup all strings from the dynamic section with the given tag.
+  std::vector<std::string> GetDynamicSectionStrings(
+    unsigned int tag) override;
+
   bool IsMips() const override { return this->ELFHeader.e_machine == EM_MIPS; }
 
   // Print information about the ELF file.
@@ -652,6 +668,66 @@ cmELF::StringEntry const* cmELFInternalImpl<Types>::GetDynamicSectionString(
   return nullptr;
 }
 
+static std::string cmELFDynamicTagName(unsigned int tag)
+{
+  switch (tag) {
+    case DT_NEEDED:
+      return "DT_NEEDED";
+    case DT_RPATH:
+      return "DT_RPATH";
+    case DT_RUNPATH:
+      return "DT_RUNPATH";
+    default:
+      break;
+  }
+  return cmStrCat("tag ", tag);
+}
+
+template <class Types>
+std::vector<std::string> cmELFInternalImpl<Types>::GetDynamicSectionStrings(
+  unsigned int tag)
+{
+  std::vector<std::string> result;
+
+  // Try reading the dynamic section.
+  if (!this->LoadDynamicSection()) {
+    return result;
+  }
+
+  // Get the string table referenced by the DYNAMIC section.
+  ELF_Shdr const& sec = this->SectionHeaders[this->DynamicSectionIndex];
+  if (sec.sh_link >= this->SectionHeaders.size()) {
+    this->SetErrorMessage("Section DYNAMIC has invalid string table index.");
+    return result;
+  }
+  ELF_Shdr const& strtab = this->SectionHeaders[sec.sh_link];
+
+  // Collect every entry with the requested tag, in order.
+  for (ELF_Dyn const& dyn : this->DynamicSectionEntries) {
+    if (static_cast<tagtype>(dyn.d_tag) != static_cast<tagtype>(tag)) {
+      continue;
+    }
+    if (dyn.d_un.d_val >= strtab.sh_size) {
+      this->SetErrorMessage("Section DYNAMIC references string beyond "
+                            "the end of its string section.");
+      result.clear();
+      return result;
+    }
+    this->Stream->seekg(strtab.sh_offset + dyn.d_un.d_val);
+    std::string value;
+    if (!std::getline(*this->Stream, value, '\0')) {
+      this->SetErrorMessage(
+        cmStrCat("Dynamic section specifies unreadable value for ",
+                 cmELFDynamicTagName(tag))
+          .c_str());
+      result.clear();
+      return result;
+    }
+    result.push_back(std::move(value));
+  }
+  return result;
+}
+
 //============================================================================
 // External class implementation.
 
@@ -798,6 +874,16 @@ cmELF::StringEntry const* cmELF::GetSOName()
   return nullptr;
 }
 
+std::vector<std::string> cmELF::GetNeeded()
+{
+  if (this->Valid() &&
+      (this->Internal->GetFileType() == cmELF::FileTypeExecutable ||
+       this->Internal->GetFileType() == cmELF::FileTypeSharedLibrary)) {
+    return this->Internal->GetNeeded();
+  }
+  return std::vector<std::string>();
+}
+
 cmELF::StringEntry const* cmELF::GetRPath()
 {
   if (this->Valid() &&
@@ -95,6 +95,9 @@ public:
   bool GetSOName(std::string& soname);
   StringEntry const* GetSOName();
 
+  /** Get the NEEDED fields, in the order they appear.  */
+  std::vector<std::string> GetNeeded();
+
   /** Get the RPATH field if any.  */
   StringEntry const* GetRPath();
 
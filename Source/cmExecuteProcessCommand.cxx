@@ -11,6 +11,7 @@
 #include <utility>
 #include <vector>
 
+#include <cm/memory>
 #include <cm/optional>
 #include <cm/string_view>
 #include <cmext/algorithm>
@@ -25,11 +26,13 @@
 #include "cmMessageType.h"
 #include "cmPolicies.h"
 #include "cmProcessOutput.h"
+#include "cmRange.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 #include "cmUVHandlePtr.h"
 #include "cmUVProcessChain.h"
 #include "cmUVStream.h"
+#include "cmake.h"
 
 namespace {
 bool cmExecuteProcessCommandIsWhitespace(char c)
@@ -41,17 +44,17 @@ void cmExecuteProcessCommandFixText(std::vector<char>& output,
                                     bool strip_trailing_whitespace);
 void cmExecuteProcessCommandAppend(std::vector<char>& output, const char* data,
                                    std::size_t length);
+void cmExecuteProcessCommandAppendLimited(std::vector<char>& output,
+                                          std::string const& data,
+                                          cm::optional<std::size_t>& limit,
+                                          bool utf8);
+bool cmExecuteProcessCommandParseLimit(std::string const& value,
+                                       cm::optional<std::size_t>& limit);
 }
 
-// cmExecuteProcessCommand
-bool cmExecuteProcessCommand(std::vector<std::string> const& args,
-                             cmExecutionStatus& status)
+class cmExecuteProcessJobs::Job
 {
-  if (args.empty()) {
-    status.SetError("called with incorrect number of arguments");
-    return false;
-  }
-
+public:
   struct Arguments : public ArgumentParser::ParseResult
   {
     std::vector<std::vector<std::string>> Commands;
@@ -64,7 +67,10 @@ bool cmExecuteProcessCommand(std::vector<std::string> const& args,
     std::string OutputFile;
     std::string ErrorFile;
     std::string Timeout;
+    std::string OutputLimit;
+    std::string ErrorLimit;
     std::string CommandEcho;
+    std::string Async;
     bool OutputQuiet = false;
     bool ErrorQuiet = false;
     bool OutputStripTrailingWhitespace = false;
@@ -75,6 +81,82 @@ bool cmExecuteProcessCommand(std::vector<std::string> const& args,
     std::string CommandErrorIsFatal;
   };
 
+  using FilePtr = std::unique_ptr<FILE, int (*)(FILE*)>;
+
+  Job(Arguments const& arguments, cm::optional<std::size_t> outputLimit,
+      cm::optional<std::size_t> errorLimit,
+      cmProcessOutput::Encoding encoding);
+
+  void Start(cmUVProcessChainBuilder const& builder, int64_t timeoutMillis,
+             FilePtr inputFile, FilePtr outputFile, FilePtr errorFile);
+  void Wait();
+  bool Finish(cmExecutionStatus& status);
+
+private:
+  struct ReadData
+  {
+    bool Finished = false;
+    std::vector<char> Output;
+    cm::uv_pipe_ptr Stream;
+  };
+
+  Arguments const Args;
+  cm::optional<std::size_t> OutputLimit;
+  cm::optional<std::size_t> ErrorLimit;
+  FilePtr InputFile{ nullptr, fclose };
+  FilePtr OutputFile{ nullptr, fclose };
+  FilePtr ErrorFile{ nullptr, fclose };
+  std::unique_ptr<cmUVProcessChain> Chain;
+  bool TimedOut = false;
+  cm::uv_timer_ptr Timer;
+  ReadData OutputData;
+  ReadData ErrorData;
+  cmProcessOutput ProcessOutput;
+  bool const DecodeUTF8;
+  std::string StrData;
+  std::unique_ptr<cmUVStreamReadHandle> OutputHandle;
+  std::unique_ptr<cmUVStreamReadHandle> ErrorHandle;
+};
+
+// cmExecuteProcessCommand
+bool cmExecuteProcessCommand(std::vector<std::string> const& args,
+                             cmExecutionStatus& status)
+{
+  if (args.empty()) {
+    status.SetError("called with incorrect number of arguments");
+    return false;
+  }
+
+  cmExecuteProcessJobs& jobs =
+    status.GetMakefile().GetCMakeInstance()->GetExecuteProcessJobs();
+
+  if (args.front() == "WAIT"_s) {
+    if (args.size() < 2) {
+      status.SetError("WAIT given no names.");
+      return false;
+    }
+    for (std::string const& name : cmMakeRange(args).advance(1)) {
+      if (!jobs.Contains(name)) {
+        status.SetError(
+          cmStrCat("WAIT given name \"", name, "\" not started by ASYNC."));
+        return false;
+      }
+    }
+    for (std::string const& name : cmMakeRange(args).advance(1)) {
+      std::unique_ptr<cmExecuteProcessJobs::Job> job = jobs.Take(name);
+      // The name may have been repeated.
+      if (!job) {
+        continue;
+      }
+      job->Wait();
+      if (!job->Finish(status)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  using Arguments = cmExecuteProcessJobs::Job::Arguments;
   static auto const parser =
     cmArgumentParser<Arguments>{}
       .Bind("COMMAND"_s, &Arguments::Commands)
@@ -88,6 +170,9 @@ bool cmExecuteProcessCommand(std::vector<std::string> const& args,
       .Bind("OUTPUT_FILE"_s, &Arguments::OutputFile)
       .Bind("ERROR_FILE"_s, &Arguments::ErrorFile)
       .Bind("TIMEOUT"_s, &Arguments::Timeout)
+      .Bind("OUTPUT_LIMIT"_s, &Arguments::OutputLimit)
+      .Bind("ERROR_LIMIT"_s, &Arguments::ErrorLimit)
+      .Bind("ASYNC"_s, &Arguments::Async)
       .Bind("OUTPUT_QUIET"_s, &Arguments::OutputQuiet)
       .Bind("ERROR_QUIET"_s, &Arguments::ErrorQuiet)
       .Bind("OUTPUT_STRIP_TRAILING_WHITESPACE"_s,
@@ -111,6 +196,12 @@ bool cmExecuteProcessCommand(std::vector<std::string> const& args,
     return false;
   }
 
+  if (!arguments.Async.empty() && jobs.Contains(arguments.Async)) {
+    status.SetError(cmStrCat("ASYNC given name \"", arguments.Async,
+                             "\" that has not been waited for."));
+    return false;
+  }
+
   std::string inputFilename = arguments.InputFile;
   std::string outputFilename = arguments.OutputFile;
   std::string errorFilename = arguments.ErrorFile;
@@ -157,6 +248,21 @@ bool cmExecuteProcessCommand(std::vector<std::string> const& args,
     }
   }
 
+  // Parse the output capture limits.
+  cm::optional<std::size_t> outputLimit;
+  if (!cmExecuteProcessCommandParseLimit(arguments.OutputLimit,
+                                         outputLimit)) {
+    status.SetError(" called with OUTPUT_LIMIT value that could not be "
+                    "parsed.");
+    return false;
+  }
+  cm::optional<std::size_t> errorLimit;
+  if (!cmExecuteProcessCommandParseLimit(arguments.ErrorLimit, errorLimit)) {
+    status.SetError(" called with ERROR_LIMIT value that could not be "
+                    "parsed.");
+    return false;
+  }
+
   if (!arguments.CommandErrorIsFatal.empty()) {
     if (arguments.CommandErrorIsFatal != "ANY"_s &&
         arguments.CommandErrorIsFatal != "LAST"_s) {
@@ -167,6 +273,10 @@ bool cmExecuteProcessCommand(std::vector<std::string> const& args,
   // Create a process instance.
   cmUVProcessChainBuilder builder;
 
+  // Run on the loop shared by all process chains so that any outstanding
+  // ASYNC chains make progress while this one runs.
+  builder.SetExternalLoop(jobs.GetLoop());
+
   // Set the command sequence.
   for (std::vector<std::string> const& cmd : arguments.Commands) {
     builder.AddCommand(cmd);
@@ -178,7 +288,7 @@ bool cmExecuteProcessCommand(std::vector<std::string> const& args,
   }
 
   // Check the output variables.
-  std::unique_ptr<FILE, int (*)(FILE*)> inputFile(nullptr, fclose);
+  cmExecuteProcessJobs::Job::FilePtr inputFile(nullptr, fclose);
   if (!inputFilename.empty()) {
     inputFile.reset(cmsys::SystemTools::Fopen(inputFilename, "rb"));
     if (inputFile) {
@@ -189,7 +299,7 @@ bool cmExecuteProcessCommand(std::vector<std::string> const& args,
     builder.SetExternalStream(cmUVProcessChainBuilder::Stream_INPUT, stdin);
   }
 
-  std::unique_ptr<FILE, int (*)(FILE*)> outputFile(nullptr, fclose);
+  cmExecuteProcessJobs::Job::FilePtr outputFile(nullptr, fclose);
   if (!outputFilename.empty()) {
     outputFile.reset(cmsys::SystemTools::Fopen(outputFilename, "wb"));
     if (outputFile) {
@@ -205,7 +315,7 @@ bool cmExecuteProcessCommand(std::vector<std::string> const& args,
     }
   }
 
-  std::unique_ptr<FILE, int (*)(FILE*)> errorFile(nullptr, fclose);
+  cmExecuteProcessJobs::Job::FilePtr errorFile(nullptr, fclose);
   if (!errorFilename.empty()) {
     if (errorFilename == outputFilename) {
       if (outputFile) {
@@ -273,31 +383,7 @@ bool cmExecuteProcessCommand(std::vector<std::string> const& args,
       std::cerr << command;
     }
   }
-  // Start the process.
-  auto chain = builder.Start();
-
-  bool timedOut = false;
-  cm::uv_timer_ptr timer;
 
-  if (timeoutMillis >= 0) {
-    timer.init(chain.GetLoop(), &timedOut);
-    timer.start(
-      [](uv_timer_t* handle) {
-        auto* timeoutPtr = static_cast<bool*>(handle->data);
-        *timeoutPtr = true;
-      },
-      timeoutMillis, 0);
-  }
-
-  // Read the process output.
-  struct ReadData
-  {
-    bool Finished = false;
-    std::vector<char> Output;
-    cm::uv_pipe_ptr Stream;
-  };
-  ReadData outputData;
-  ReadData errorData;
   cmPolicies::PolicyStatus const cmp0176 =
     status.GetMakefile().GetPolicyStatus(cmPolicies::CMP0176);
   cmProcessOutput::Encoding encoding =
@@ -315,96 +401,170 @@ bool cmExecuteProcessCommand(std::vector<std::string> const& args,
                  "\".  Ignoring."));
     }
   }
-  cmProcessOutput processOutput(encoding);
-  std::string strdata;
-
-  std::unique_ptr<cmUVStreamReadHandle> outputHandle;
-  if (chain.OutputStream() >= 0) {
-    outputData.Stream.init(chain.GetLoop(), 0);
-    uv_pipe_open(outputData.Stream, chain.OutputStream());
-    outputHandle = cmUVStreamRead(
-      outputData.Stream,
-      [&arguments, &processOutput, &outputData,
-       &strdata](std::vector<char> data) {
-        if (!arguments.OutputQuiet) {
-          if (arguments.OutputVariable.empty() ||
-              arguments.EchoOutputVariable) {
-            processOutput.DecodeText(data.data(), data.size(), strdata, 1);
-            cmSystemTools::Stdout(strdata);
+
+  // Start the process.
+  auto job = cm::make_unique<cmExecuteProcessJobs::Job>(
+    arguments, outputLimit, errorLimit, encoding);
+  job->Start(builder, timeoutMillis, std::move(inputFile),
+             std::move(outputFile), std::move(errorFile));
+
+  // Leave an asynchronous process to be collected by a later WAIT.
+  if (!arguments.Async.empty()) {
+    jobs.Add(arguments.Async, std::move(job));
+    return true;
+  }
+
+  job->Wait();
+  return job->Finish(status);
+}
+
+cmExecuteProcessJobs::Job::Job(Arguments const& arguments,
+                               cm::optional<std::size_t> outputLimit,
+                               cm::optional<std::size_t> errorLimit,
+                               cmProcessOutput::Encoding encoding)
+  : Args(arguments)
+  , OutputLimit(outputLimit)
+  , ErrorLimit(errorLimit)
+  , ProcessOutput(encoding)
+  , DecodeUTF8(encoding != cmProcessOutput::None)
+{
+}
+
+void cmExecuteProcessJobs::Job::Start(cmUVProcessChainBuilder const& builder,
+                                      int64_t timeoutMillis,
+                                      FilePtr inputFile, FilePtr outputFile,
+                                      FilePtr errorFile)
+{
+  // The files must stay open as long as the processes may write to them.
+  this->InputFile = std::move(inputFile);
+  this->OutputFile = std::move(outputFile);
+  this->ErrorFile = std::move(errorFile);
+
+  this->Chain = cm::make_unique<cmUVProcessChain>(builder.Start());
+
+  if (timeoutMillis >= 0) {
+    this->Timer.init(this->Chain->GetLoop(), &this->TimedOut);
+    this->Timer.start(
+      [](uv_timer_t* handle) {
+        auto* timeoutPtr = static_cast<bool*>(handle->data);
+        *timeoutPtr = true;
+      },
+      timeoutMillis, 0);
+  }
+
+  // Read the process output.
+  if (this->Chain->OutputStream() >= 0) {
+    this->OutputData.Stream.init(this->Chain->GetLoop(), 0);
+    uv_pipe_open(this->OutputData.Stream, this->Chain->OutputStream());
+    this->OutputHandle = cmUVStreamRead(
+      this->OutputData.Stream,
+      [this](std::vector<char> data) {
+        if (!this->Args.OutputQuiet) {
+          // Decode each chunk as it arrives so that only the captured
+          // portion of the output is ever held in memory.
+          this->ProcessOutput.DecodeText(data.data(), data.size(),
+                                         this->StrData, 1);
+          if (this->Args.OutputVariable.empty() ||
+              this->Args.EchoOutputVariable) {
+            cmSystemTools::Stdout(this->StrData);
           }
-          if (!arguments.OutputVariable.empty()) {
-            cmExecuteProcessCommandAppend(outputData.Output, data.data(),
-                                          data.size());
+          if (!this->Args.OutputVariable.empty()) {
+            cmExecuteProcessCommandAppendLimited(
+              this->OutputData.Output, this->StrData, this->OutputLimit,
+              this->DecodeUTF8);
           }
         }
       },
-      [&outputData]() { outputData.Finished = true; });
+      [this]() { this->OutputData.Finished = true; });
   } else {
-    outputData.Finished = true;
-  }
-  std::unique_ptr<cmUVStreamReadHandle> errorHandle;
-  if (chain.ErrorStream() >= 0 &&
-      chain.ErrorStream() != chain.OutputStream()) {
-    errorData.Stream.init(chain.GetLoop(), 0);
-    uv_pipe_open(errorData.Stream, chain.ErrorStream());
-    errorHandle = cmUVStreamRead(
-      errorData.Stream,
-      [&arguments, &processOutput, &errorData,
-       &strdata](std::vector<char> data) {
-        if (!arguments.ErrorQuiet) {
-          if (arguments.ErrorVariable.empty() || arguments.EchoErrorVariable) {
-            processOutput.DecodeText(data.data(), data.size(), strdata, 2);
-            cmSystemTools::Stderr(strdata);
+    this->OutputData.Finished = true;
+  }
+  if (this->Chain->ErrorStream() >= 0 &&
+      this->Chain->ErrorStream() != this->Chain->OutputStream()) {
+    this->ErrorData.Stream.init(this->Chain->GetLoop(), 0);
+    uv_pipe_open(this->ErrorData.Stream, this->Chain->ErrorStream());
+    this->ErrorHandle = cmUVStreamRead(
+      this->ErrorData.Stream,
+      [this](std::vector<char> data) {
+        if (!this->Args.ErrorQuiet) {
+          this->ProcessOutput.DecodeText(data.data(), data.size(),
+                                         this->StrData, 2);
+          if (this->Args.ErrorVariable.empty() ||
+              this->Args.EchoErrorVariable) {
+            cmSystemTools::Stderr(this->StrData);
           }
-          if (!arguments.ErrorVariable.empty()) {
-            cmExecuteProcessCommandAppend(errorData.Output, data.data(),
-                                          data.size());
+          if (!this->Args.ErrorVariable.empty()) {
+            cmExecuteProcessCommandAppendLimited(
+              this->ErrorData.Output, this->StrData, this->ErrorLimit,
+              this->DecodeUTF8);
           }
         }
       },
-      [&errorData]() { errorData.Finished = true; });
+      [this]() { this->ErrorData.Finished = true; });
   } else {
-    errorData.Finished = true;
+    this->ErrorData.Finished = true;
   }
+}
 
-  while (chain.Valid() && !timedOut &&
-         !(chain.Finished() && outputData.Finished && errorData.Finished)) {
-    uv_run(&chain.GetLoop(), UV_RUN_ONCE);
+void cmExecuteProcessJobs::Job::Wait()
+{
+  while (this->Chain->Valid() && !this->TimedOut &&
+         !(this->Chain->Finished() && this->OutputData.Finished &&
+           this->ErrorData.Finished)) {
+    uv_run(&this->Chain->GetLoop(), UV_RUN_ONCE);
   }
-  if (!arguments.OutputQuiet &&
-      (arguments.OutputVariable.empty() || arguments.EchoOutputVariable)) {
-    processOutput.DecodeText(std::string(), strdata, 1);
+}
+
+bool cmExecuteProcessJobs::Job::Finish(cmExecutionStatus& status)
+{
+  Arguments const& arguments = this->Args;
+  cmUVProcessChain& chain = *this->Chain;
+  bool const timedOut = this->TimedOut;
+  std::string& strdata = this->StrData;
+
+  // All output has been read.  Flush any partially decoded characters.
+  if (!arguments.OutputQuiet) {
+    this->ProcessOutput.DecodeText(std::string(), strdata, 1);
     if (!strdata.empty()) {
-      cmSystemTools::Stdout(strdata);
+      if (arguments.OutputVariable.empty() || arguments.EchoOutputVariable) {
+        cmSystemTools::Stdout(strdata);
+      }
+      if (!arguments.OutputVariable.empty()) {
+        cmExecuteProcessCommandAppendLimited(this->OutputData.Output, strdata,
+                                             this->OutputLimit,
+                                             this->DecodeUTF8);
+      }
     }
   }
-  if (!arguments.ErrorQuiet &&
-      (arguments.ErrorVariable.empty() || arguments.EchoErrorVariable)) {
-    processOutput.DecodeText(std::string(), strdata, 2);
+  if (!arguments.ErrorQuiet) {
+    this->ProcessOutput.DecodeText(std::string(), strdata, 2);
     if (!strdata.empty()) {
-      cmSystemTools::Stderr(strdata);
+      if (arguments.ErrorVariable.empty() || arguments.EchoErrorVariable) {
+        cmSystemTools::Stderr(strdata);
+      }
+      if (!arguments.ErrorVariable.empty()) {
+        cmExecuteProcessCommandAppendLimited(this->ErrorData.Output, strdata,
+                                             this->ErrorLimit,
+                                             this->DecodeUTF8);
+      }
     }
   }
 
-  // All output has been read.
-  processOutput.DecodeText(outputData.Output, outputData.Output);
-  processOutput.DecodeText(errorData.Output, errorData.Output);
-
   // Fix the text in the output strings.
-  cmExecuteProcessCommandFixText(outputData.Output,
+  cmExecuteProcessCommandFixText(this->OutputData.Output,
                                  arguments.OutputStripTrailingWhitespace);
-  cmExecuteProcessCommandFixText(errorData.Output,
+  cmExecuteProcessCommandFixText(this->ErrorData.Output,
                                  arguments.ErrorStripTrailingWhitespace);
 
   // Store the output obtained.
-  if (!arguments.OutputVariable.empty() && !outputData.Output.empty()) {
+  if (!arguments.OutputVariable.empty() && !this->OutputData.Output.empty()) {
     status.GetMakefile().AddDefinition(arguments.OutputVariable,
-                                       outputData.Output.data());
+                                       this->OutputData.Output.data());
   }
   if (arguments.ErrorVariable != arguments.OutputVariable &&
-      !arguments.ErrorVariable.empty() && !errorData.Output.empty()) {
+      !arguments.ErrorVariable.empty() && !this->ErrorData.Output.empty()) {
     status.GetMakefile().AddDefinition(arguments.ErrorVariable,
-                                       errorData.Output.data());
+                                       this->ErrorData.Output.data());
   }
 
   // Store the result of running the process.
@@ -519,6 +679,36 @@ bool cmExecuteProcessCommand(std::vector<std::string> const& args,
   return true;
 }
 
+cmExecuteProcessJobs::cmExecuteProcessJobs()
+{
+  this->Loop.init();
+}
+
+cmExecuteProcessJobs::~cmExecuteProcessJobs() = default;
+
+bool cmExecuteProcessJobs::Contains(std::string const& name) const
+{
+  return this->Jobs.find(name) != this->Jobs.end();
+}
+
+void cmExecuteProcessJobs::Add(std::string const& name,
+                               std::unique_ptr<Job> job)
+{
+  this->Jobs[name] = std::move(job);
+}
+
+std::unique_ptr<cmExecuteProcessJobs::Job> cmExecuteProcessJobs::Take(
+  std::string const& name)
+{
+  std::unique_ptr<Job> job;
+  auto i = this->Jobs.find(name);
+  if (i != this->Jobs.end()) {
+    job = std::move(i->second);
+    this->Jobs.erase(i);
+  }
+  return job;
+}
+
 namespace {
 void cmExecuteProcessCommandFixText(std::vector<char>& output,
                                     bool strip_trailing_whitespace)
@@ -565,4 +755,43 @@ void cmExecuteProcessCommandAppend(std::vector<char>& output, const char* data,
 #endif
   cm::append(output, data, data + length);
 }
+
+void cmExecuteProcessCommandAppendLimited(std::vector<char>& output,
+                                          std::string const& data,
+                                          cm::optional<std::size_t>& limit,
+                                          bool utf8)
+{
+  std::size_t length = data.size();
+  if (limit) {
+    if (output.size() >= *limit) {
+      return;
+    }
+    std::size_t const room = *limit - output.size();
+    if (length > room) {
+      // Do not split a UTF-8 encoded character of decoded output.
+      length = room;
+      while (utf8 && length > 0 &&
+             (static_cast<unsigned char>(data[length]) & 0xC0) == 0x80) {
+        --length;
+      }
+      // Drop everything after the truncation point.
+      limit = output.size() + length;
+    }
+  }
+  cmExecuteProcessCommandAppend(output, data.data(), length);
+}
+
+bool cmExecuteProcessCommandParseLimit(std::string const& value,
+                                       cm::optional<std::size_t>& limit)
+{
+  if (value.empty()) {
+    return true;
+  }
+  unsigned long n;
+  if (!cmStrToULong(value, &n)) {
+    return false;
+  }
+  limit = static_cast<std::size_t>(n);
+  return true;
+}
 }
@@ -4,9 +4,15 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include <cm3p/uv.h>
+
+#include "cmUVHandlePtr.h"
+
 class cmExecutionStatus;
 
 /**
@@ -17,3 +23,33 @@ class cmExecutionStatus;
  */
 bool cmExecuteProcessCommand(std::vector<std::string> const& args,
                              cmExecutionStatus& status);
+
+/**
+ * \brief Process chains started by execute_process.
+ *
+ * All execute_process calls of a cmake instance run their process chains
+ * on one shared event loop.  Chains started with the ASYNC option are
+ * kept here by name until collected with the WAIT signature, and their
+ * output is read whenever CMake waits on any other chain.
+ */
+class cmExecuteProcessJobs
+{
+public:
+  class Job;
+
+  cmExecuteProcessJobs();
+  ~cmExecuteProcessJobs();
+
+  cmExecuteProcessJobs(cmExecuteProcessJobs const&) = delete;
+  cmExecuteProcessJobs& operator=(cmExecuteProcessJobs const&) = delete;
+
+  uv_loop_t& GetLoop() { return *this->Loop; }
+
+  bool Contains(std::string const& name) const;
+  void Add(std::string const& name, std::unique_ptr<Job> job);
+  std::unique_ptr<Job> Take(std::string const& name);
+
+private:
+  cm::uv_loop_ptr Loop;
+  std::map<std::string, std::unique_ptr<Job>> Jobs;
+};
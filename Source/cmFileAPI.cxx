@@ -107,6 +107,9 @@ std::vector<unsigned long> cmFileAPI::GetConfigureLogVersions()
 
 void cmFileAPI::WriteReplies()
 {
+  auto profilingRAII =
+    this->CMakeInstance->CreateProfilingEntry("fileapi", "reply");
+
   if (this->QueryExists) {
     cmSystemTools::MakeDirectory(this->APIv1 + "/reply");
     this->WriteJsonFile(this->BuildReplyIndex(), "index", ComputeSuffixTime);
@@ -186,33 +189,36 @@ std::string cmFileAPI::WriteJsonFile(
   Json::Value const& value, std::string const& prefix,
   std::string (*computeSuffix)(std::string const&))
 {
-  std::string fileName;
-
-  // Write the json file with a temporary name.
-  std::string const& tmpFile = this->APIv1 + "/tmp.json";
-  cmsys::ofstream ftmp(tmpFile.c_str());
-  this->JsonWriter->write(value, &ftmp);
-  ftmp << "\n";
-  ftmp.close();
-  if (!ftmp) {
-    cmSystemTools::RemoveFile(tmpFile);
-    return fileName;
-  }
+  // Serialize the json in memory so its final name can be computed
+  // without a round trip through the file system.
+  std::ostringstream content;
+  this->JsonWriter->write(value, &content);
+  content << "\n";
+  std::string const& text = content.str();
 
   // Compute the final name for the file.
-  fileName = prefix + "-" + computeSuffix(tmpFile) + ".json";
+  std::string fileName = prefix + "-" + computeSuffix(text) + ".json";
 
-  // Create the destination.
-  std::string file = this->APIv1 + "/reply";
-  cmSystemTools::MakeDirectory(file);
-  file += "/";
-  file += fileName;
+  std::string const replyDir = this->APIv1 + "/reply";
+  std::string const file = cmStrCat(replyDir, '/', fileName);
 
   // If the final name already exists then assume it has proper content.
-  // Otherwise, atomically place the reply file at its final name
-  if (cmSystemTools::FileExists(file, true) ||
-      !cmSystemTools::RenameFile(tmpFile, file)) {
-    cmSystemTools::RemoveFile(tmpFile);
+  // Otherwise, write the json file with a temporary name and atomically
+  // place the reply file at its final name.
+  if (!cmSystemTools::FileExists(file, true)) {
+    std::string const& tmpFile = this->APIv1 + "/tmp.json";
+    cmsys::ofstream ftmp(tmpFile.c_str());
+    ftmp << text;
+    ftmp.close();
+    if (!ftmp) {
+      cmSystemTools::RemoveFile(tmpFile);
+      return std::string();
+    }
+
+    cmSystemTools::MakeDirectory(replyDir);
+    if (!cmSystemTools::RenameFile(tmpFile, file)) {
+      cmSystemTools::RemoveFile(tmpFile);
+    }
   }
 
   // Record this among files we have just written.
@@ -233,10 +239,10 @@ Json::Value cmFileAPI::MaybeJsonFile(Json::Value in, std::string const& prefix)
   return out;
 }
 
-std::string cmFileAPI::ComputeSuffixHash(std::string const& file)
+std::string cmFileAPI::ComputeSuffixHash(std::string const& content)
 {
   cmCryptoHash hasher(cmCryptoHash::AlgoSHA3_256);
-  std::string hash = hasher.HashFile(file);
+  std::string hash = hasher.HashString(content);
   hash.resize(20, '0');
   return hash;
 }
@@ -446,6 +452,8 @@ Json::Value const& cmFileAPI::AddReplyIndexObject(Object const& o)
   }
 
   // Generate this reply object.
+  auto profilingRAII =
+    this->CMakeInstance->CreateProfilingEntry("fileapi", ObjectName(o));
   Json::Value const& object = this->BuildObject(o);
   assert(object.isObject());
 
@@ -710,7 +710,10 @@ Json::Value CodemodelConfig::DumpTarget(cmGeneratorTarget* gt,
   if (!this->Config.empty()) {
     prefix += "-" + this->Config;
   }
+  auto profilingRAII =
+    this->FileAPI.GetCMakeInstance()->CreateProfilingEntry("fileapi", prefix);
   Json::Value target = this->FileAPI.MaybeJsonFile(t.Dump(), prefix);
+  profilingRAII.reset();
   target["name"] = gt->GetName();
   target["id"] = TargetId(gt, this->TopBuild);
 
@@ -23,6 +23,7 @@
 
 #include <cm3p/kwiml/int.h>
 
+#include "cmsys/Directory.hxx"
 #include "cmsys/FStream.hxx"
 #include "cmsys/Glob.hxx"
 #include "cmsys/RegularExpression.hxx"
@@ -40,6 +41,7 @@
 #include "cmFileCopier.h"
 #include "cmFileInstaller.h"
 #include "cmFileLockPool.h"
+#include "cmFileTime.h"
 #include "cmFileTimes.h"
 #include "cmGeneratedFileStream.h"
 #include "cmGeneratorExpression.h"
@@ -67,6 +69,7 @@
 #  include <cm3p/curl/curl.h>
 
 #  include "cmCurl.h"
+#  include "cmFileLock.h"
 #  include "cmFileLockResult.h"
 #endif
 
@@ -662,6 +665,64 @@ bool HandleStringsCommand(std::vector<std::string> const& args,
   return true;
 }
 
+bool SnapshotGlobDirectory(
+  std::string const& dir, bool recurse, cmFileTime const& now,
+  std::vector<std::pair<std::string, cmFileTime>>& directories)
+{
+  // A directory modified too recently may change again without its
+  // modification time changing, so it cannot be trusted.
+  cmFileTime dirTime;
+  if (!dirTime.Load(dir) ||
+      now.GetTime() - dirTime.GetTime() < 2 * cmFileTime::UtPerS) {
+    return false;
+  }
+  directories.emplace_back(dir, dirTime);
+  if (!recurse) {
+    return true;
+  }
+  cmsys::Directory d;
+  if (!d.Load(dir)) {
+    return false;
+  }
+  std::string const prefix = cmHasLiteralSuffix(dir, "/") ? dir : dir + "/";
+  for (unsigned long i = 0; i < d.GetNumberOfFiles(); ++i) {
+    std::string const& name = d.GetFileName(i);
+    if (name == "." || name == ".." || !d.FileIsDirectory(i) ||
+        d.FileIsSymlink(i)) {
+      continue;
+    }
+    if (!SnapshotGlobDirectory(prefix + name, true, now, directories)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Record the directories whose entries a CONFIGURE_DEPENDS glob lists so
+// that build-time verification can skip the glob while none of them change.
+// Expressions with wildcards in their directory part are not recorded.
+std::vector<std::pair<std::string, cmFileTime>> SnapshotGlobDirectories(
+  std::string const& expr, bool recurse, bool followSymlinks)
+{
+  std::vector<std::pair<std::string, cmFileTime>> directories;
+  std::string::size_type const slash = expr.rfind('/');
+  if (followSymlinks || slash == std::string::npos ||
+      expr.find('\\') != std::string::npos ||
+      expr.find_first_of("*?[]") < slash) {
+    return directories;
+  }
+  std::string dir = expr.substr(0, slash);
+  if (dir.empty() || dir.back() == ':') {
+    dir += '/';
+  }
+  cmFileTime now;
+  now.LoadNow();
+  if (!SnapshotGlobDirectory(dir, recurse, now, directories)) {
+    directories.clear();
+  }
+  return directories;
+}
+
 bool HandleGlobImpl(std::vector<std::string> const& args, bool recurse,
                     cmExecutionStatus& status)
 {
@@ -780,6 +841,12 @@ bool HandleGlobImpl(std::vector<std::string> const& args, bool recurse,
         }
       }
 
+      std::vector<std::pair<std::string, cmFileTime>> globDirectories;
+      if (configureDepends) {
+        globDirectories = SnapshotGlobDirectories(
+          expr, recurse, recurse && g.GetRecurseThroughSymlinks());
+      }
+
       cmsys::Glob::GlobMessages globMessages;
       g.FindFiles(expr, &globMessages);
 
@@ -829,6 +896,7 @@ bool HandleGlobImpl(std::vector<std::string> const& args, bool recurse,
           expr,
           foundFiles
         };
+        entry.Directories = std::move(globDirectories);
         cm->AddGlobCacheEntry(entry, variable,
                               status.GetMakefile().GetBacktrace());
       } else {
@@ -1905,6 +1973,103 @@ private:
   ::CURL* Easy;
 };
 
+// Copy 'from' to 'to', cloning its content when the file system allows.
+// Never hard link: the two files must not share one mutable inode.
+bool CloneOrCopyFile(std::string const& from, std::string const& to)
+{
+  cmSystemTools::RemoveFile(to);
+  return cmSystemTools::CopySingleFile(from, to,
+                                       cmSystemTools::CopyWhen::Always,
+                                       cmSystemTools::CopyInputRecent::No) ==
+    cmSystemTools::CopyResult::Success;
+}
+
+/** Entry in the content-addressed download cache.
+
+    The cache is a directory named by CMAKE_DOWNLOAD_CACHE_DIR, holding
+    files at '<algo>/<hash>'.  Each entry is guarded by a '.lock' file,
+    held from lookup until the download completes, so that concurrent
+    processes fetch the same content only once.  */
+class DownloadCacheEntry
+{
+public:
+  bool Open(cmMakefile const& mf, std::string const& algo,
+            std::string const& expectedHash);
+  bool Fetch(std::string const& file, cmCryptoHash& hash,
+             std::string const& expectedHash);
+  void Store(std::string const& file);
+
+private:
+  std::string Path;
+  cmFileLock Lock;
+};
+
+bool DownloadCacheEntry::Open(cmMakefile const& mf, std::string const& algo,
+                              std::string const& expectedHash)
+{
+  std::string dir;
+  if (cmValue v = mf.GetDefinition("CMAKE_DOWNLOAD_CACHE_DIR")) {
+    dir = *v;
+  } else if (cm::optional<std::string> e =
+               cmSystemTools::GetEnvVar("CMAKE_DOWNLOAD_CACHE_DIR")) {
+    dir = std::move(*e);
+  }
+  if (dir.empty() || expectedHash.empty() ||
+      expectedHash.find_first_not_of("0123456789abcdef") !=
+        std::string::npos) {
+    return false;
+  }
+  dir = cmStrCat(cmSystemTools::CollapseFullPath(dir), '/',
+                 cmSystemTools::LowerCase(algo));
+  if (!cmSystemTools::MakeDirectory(dir)) {
+    return false;
+  }
+
+  std::string const path = cmStrCat(dir, '/', expectedHash);
+  std::string const lockFile = cmStrCat(path, ".lock");
+  FILE* f = cmsys::SystemTools::Fopen(lockFile, "a");
+  if (!f) {
+    return false;
+  }
+  fclose(f);
+  if (!this->Lock.Lock(lockFile, static_cast<unsigned long>(-1)).IsOk()) {
+    return false;
+  }
+  this->Path = path;
+  return true;
+}
+
+bool DownloadCacheEntry::Fetch(std::string const& file, cmCryptoHash& hash,
+                               std::string const& expectedHash)
+{
+  if (this->Path.empty() || !cmSystemTools::FileExists(this->Path, true)) {
+    return false;
+  }
+  if (hash.HashFile(this->Path) != expectedHash) {
+    // Drop a corrupt entry and download it again.
+    cmSystemTools::RemoveFile(this->Path);
+    return false;
+  }
+  std::string const dir = cmSystemTools::GetFilenamePath(file);
+  if (!dir.empty() && !cmSystemTools::MakeDirectory(dir)) {
+    return false;
+  }
+  return CloneOrCopyFile(this->Path, file);
+}
+
+void DownloadCacheEntry::Store(std::string const& file)
+{
+  if (this->Path.empty()) {
+    return;
+  }
+  // Populate the entry atomically so readers never see a partial file.
+  std::string const tmp = cmStrCat(this->Path, ".tmp");
+  if (!CloneOrCopyFile(file, tmp) ||
+      !cmSystemTools::RenameFile(tmp, this->Path)) {
+    cmSystemTools::RemoveFile(tmp);
+  }
+}
+
 #endif
 
 #define check_curl_result(result, errstr)                                     \
@@ -1944,6 +2109,7 @@ bool HandleDownloadCommand(std::vector<std::string> const& args,
   std::string netrc_file =
     status.GetMakefile().GetSafeDefinition("CMAKE_NETRC_FILE");
   std::string expectedHash;
+  std::string hashAlgo;
   std::string hashMatchMSG;
   std::unique_ptr<cmCryptoHash> hash;
   bool showProgress = false;
@@ -2037,6 +2203,7 @@ bool HandleDownloadCommand(std::vector<std::string> const& args,
         return false;
       }
       hash = cm::make_unique<cmCryptoHash>(cmCryptoHash::AlgoMD5);
+      hashAlgo = "MD5";
       hashMatchMSG = "MD5 sum";
       expectedHash = cmSystemTools::LowerCase(*i);
     } else if (*i == "SHOW_PROGRESS") {
@@ -2063,6 +2230,7 @@ bool HandleDownloadCommand(std::vector<std::string> const& args,
         status.SetError(err);
         return false;
       }
+      hashAlgo = algo;
       hashMatchMSG = algo + " hash";
     } else if (*i == "USERPWD") {
       ++i;
@@ -2166,6 +2334,21 @@ bool HandleDownloadCommand(std::vector<std::string> const& args,
       return true;
     }
   }
+  // If the expected content is in the download cache, use it.
+  //
+  DownloadCacheEntry cacheEntry;
+  if (hash && curl_ranges.empty() &&
+      cacheEntry.Open(status.GetMakefile(), hashAlgo, expectedHash) &&
+      cacheEntry.Fetch(file, *hash, expectedHash)) {
+    if (!statusVar.empty()) {
+      status.GetMakefile().AddDefinition(
+        statusVar,
+        cmStrCat(0, ";\"skipping download as file was found in the download "
+                    "cache with expected ",
+                 hashMatchMSG, '"'));
+    }
+    return true;
+  }
   // Make sure parent directory exists so we can write to the file
   // as we receive downloaded bits from curl...
   //
@@ -2412,6 +2595,8 @@ bool HandleDownloadCommand(std::vector<std::string> const& args,
                                actualHash, "]\n"));
       return false;
     }
+
+    cacheEntry.Store(file);
   }
 
   return true;
@@ -3668,6 +3853,7 @@ bool HandleArchiveCreateCommand(std::vector<std::string> const& args,
     std::string Format;
     std::string Compression;
     std::string CompressionLevel;
+    std::string Threads;
     // "MTIME" should require one value, but it has long been accidentally
     // accepted without one and treated as if an empty value were given.
     // Fixing this would require a policy.
@@ -3684,6 +3870,7 @@ bool HandleArchiveCreateCommand(std::vector<std::string> const& args,
       .Bind("FORMAT"_s, &Arguments::Format)
       .Bind("COMPRESSION"_s, &Arguments::Compression)
       .Bind("COMPRESSION_LEVEL"_s, &Arguments::CompressionLevel)
+      .Bind("THREADS"_s, &Arguments::Threads)
       .Bind("MTIME"_s, &Arguments::MTime)
       .Bind("WORKING_DIRECTORY"_s, &Arguments::WorkingDirectory)
       .Bind("VERBOSE"_s, &Arguments::Verbose)
@@ -3779,6 +3966,15 @@ bool HandleArchiveCreateCommand(std::vector<std::string> const& args,
     }
   }
 
+  long threads = 1;
+  if (!parsedArgs.Threads.empty() &&
+      !cmStrToLong(parsedArgs.Threads, &threads)) {
+    status.SetError(cmStrCat("THREADS value \"", parsedArgs.Threads,
+                             "\" is not an integer"));
+    cmSystemTools::SetFatalErrorOccurred();
+    return false;
+  }
+
   if (parsedArgs.Paths.empty()) {
     status.SetError("ARCHIVE_CREATE requires a non-empty list of PATHS");
     cmSystemTools::SetFatalErrorOccurred();
@@ -3788,7 +3984,8 @@ bool HandleArchiveCreateCommand(std::vector<std::string> const& args,
   if (!cmSystemTools::CreateTar(parsedArgs.Output, parsedArgs.Paths,
                                 parsedArgs.WorkingDirectory, compress,
                                 parsedArgs.Verbose, parsedArgs.MTime,
-                                parsedArgs.Format, compressionLevel)) {
+                                parsedArgs.Format, compressionLevel,
+                                static_cast<int>(threads))) {
     status.SetError(cmStrCat("failed to compress: ", parsedArgs.Output));
     cmSystemTools::SetFatalErrorOccurred();
     return false;
@@ -3808,6 +4005,7 @@ bool HandleArchiveExtractCommand(std::vector<std::string> const& args,
     std::string Destination;
     ArgumentParser::MaybeEmpty<std::vector<std::string>> Patterns;
     bool Touch = false;
+    std::string Threads;
   };
 
   static auto const parser = cmArgumentParser<Arguments>{}
@@ -3816,7 +4014,8 @@ bool HandleArchiveExtractCommand(std::vector<std::string> const& args,
                                .Bind("LIST_ONLY"_s, &Arguments::ListOnly)
                                .Bind("DESTINATION"_s, &Arguments::Destination)
                                .Bind("PATTERNS"_s, &Arguments::Patterns)
-                               .Bind("TOUCH"_s, &Arguments::Touch);
+                               .Bind("TOUCH"_s, &Arguments::Touch)
+                               .Bind("THREADS"_s, &Arguments::Threads);
 
   std::vector<std::string> unrecognizedArguments;
   auto parsedArgs =
@@ -3833,6 +4032,15 @@ bool HandleArchiveExtractCommand(std::vector<std::string> const& args,
     return true;
   }
 
+  long threads = 1;
+  if (!parsedArgs.Threads.empty() &&
+      !cmStrToLong(parsedArgs.Threads, &threads)) {
+    status.SetError(cmStrCat("THREADS value \"", parsedArgs.Threads,
+                             "\" is not an integer"));
+    cmSystemTools::SetFatalErrorOccurred();
+    return false;
+  }
+
   std::string inFile = parsedArgs.Input;
 
   if (parsedArgs.ListOnly) {
@@ -3875,7 +4083,7 @@ bool HandleArchiveExtractCommand(std::vector<std::string> const& args,
           inFile, parsedArgs.Patterns,
           parsedArgs.Touch ? cmSystemTools::cmTarExtractTimestamps::No
                            : cmSystemTools::cmTarExtractTimestamps::Yes,
-          parsedArgs.Verbose)) {
+          parsedArgs.Verbose, static_cast<int>(threads))) {
       status.SetError(cmStrCat("failed to extract: ", inFile));
       cmSystemTools::SetFatalErrorOccurred();
       return false;
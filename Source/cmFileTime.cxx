@@ -2,6 +2,7 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmFileTime.h"
 
+#include <chrono>
 #include <string>
 
 // Use a platform-specific API to get file times efficiently.
@@ -48,3 +49,20 @@ bool cmFileTime::Load(std::string const& fileName)
 #endif
   return true;
 }
+
+void cmFileTime::LoadNow()
+{
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  this->Time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::system_clock::now().time_since_epoch())
+                 .count();
+#else
+  FILETIME ftime;
+  GetSystemTimeAsFileTime(&ftime);
+
+  using uint64 = unsigned long long;
+
+  this->Time = static_cast<TimeType>((uint64(ftime.dwHighDateTime) << 32) +
+                                     ftime.dwLowDateTime);
+#endif
+}
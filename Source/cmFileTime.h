@@ -33,6 +33,11 @@ public:
    */
   bool Load(std::string const& fileName);
 
+  /**
+   * @brief Sets the time to the current system time
+   */
+  void LoadNow();
+
   /**
    * @brief Return true if this is older than ftm
    */
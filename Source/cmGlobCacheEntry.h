@@ -5,8 +5,11 @@
 #include "cmConfigure.h" // IWYU pragma: keep
 
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "cmFileTime.h"
+
 struct cmGlobCacheEntry
 {
   const bool Recurse;
@@ -15,6 +18,9 @@ struct cmGlobCacheEntry
   const std::string Relative;
   const std::string Expression;
   std::vector<std::string> Files;
+  // Directories listed by the glob and their modification times, recorded
+  // before globbing.  Empty if the expression cannot be checked this way.
+  std::vector<std::pair<std::string, cmFileTime>> Directories;
 
   cmGlobCacheEntry(bool recurse, bool listDirectories, bool followSymlinks,
                    std::string relative, std::string expression,
@@ -2,9 +2,20 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmGlobVerificationManager.h"
 
+#include <algorithm>
+#include <iostream>
 #include <sstream>
+#ifndef CMAKE_BOOTSTRAP
+#  include <atomic>
+#  include <thread>
+#endif
+
+#include <cm3p/json/reader.h>
+#include <cm3p/json/value.h>
+#include <cm3p/json/writer.h>
 
 #include "cmsys/FStream.hxx"
+#include "cmsys/Glob.hxx"
 
 #include "cmGeneratedFileStream.h"
 #include "cmGlobCacheEntry.h"
@@ -13,85 +24,193 @@
 #include "cmMessenger.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
-#include "cmVersion.h"
 
-bool cmGlobVerificationManager::SaveVerificationScript(const std::string& path,
-                                                       cmMessenger* messenger)
+bool cmGlobVerificationManager::SaveVerificationData(const std::string& path)
 {
   if (this->Cache.empty()) {
     return true;
   }
 
-  std::string scriptFile = cmStrCat(path, "/CMakeFiles");
-  std::string stampFile = scriptFile;
-  cmSystemTools::MakeDirectory(scriptFile);
-  scriptFile += "/VerifyGlobs.cmake";
+  std::string dataFile = cmStrCat(path, "/CMakeFiles");
+  std::string stampFile = dataFile;
+  cmSystemTools::MakeDirectory(dataFile);
+  dataFile += "/VerifyGlobs.json";
   stampFile += "/cmake.verify_globs";
-  cmGeneratedFileStream verifyScriptFile(scriptFile);
-  verifyScriptFile.SetCopyIfDifferent(true);
-  if (!verifyScriptFile) {
-    cmSystemTools::Error("Unable to open verification script file for save. " +
-                         scriptFile);
-    cmSystemTools::ReportLastSystemError("");
-    return false;
+
+  // Write the globs for the native verifier, together with the directory
+  // modification times recorded before globbing.
+  {
+    Json::Value data = Json::objectValue;
+    data["stamp"] = stampFile;
+    Json::Value& globs = data["globs"] = Json::arrayValue;
+    for (auto const& i : this->Cache) {
+      CacheEntryKey const& k = i.first;
+      CacheEntryValue const& v = i.second;
+      if (!v.Initialized) {
+        continue;
+      }
+      Json::Value glob = Json::objectValue;
+      glob["recurse"] = k.Recurse;
+      glob["listDirectories"] = k.ListDirectories;
+      glob["followSymlinks"] = k.FollowSymlinks;
+      glob["relative"] = k.Relative;
+      glob["expression"] = k.Expression;
+      Json::Value& files = glob["files"] = Json::arrayValue;
+      for (std::string const& file : v.Files) {
+        files.append(file);
+      }
+      Json::Value& directories = glob["directories"] = Json::arrayValue;
+      for (auto const& dir : v.Directories) {
+        Json::Value directory = Json::objectValue;
+        directory["path"] = dir.first;
+        directory["mtime"] =
+          static_cast<Json::Value::Int64>(dir.second.GetTime());
+        directories.append(directory);
+      }
+      globs.append(glob);
+    }
+    cmGeneratedFileStream dataStream(dataFile);
+    dataStream.SetCopyIfDifferent(true);
+    if (!dataStream) {
+      cmSystemTools::Error("Unable to open verification data file for save. " +
+                           dataFile);
+      cmSystemTools::ReportLastSystemError("");
+      return false;
+    }
+    dataStream << data;
   }
 
-  verifyScriptFile << std::boolalpha;
-  verifyScriptFile << "# CMAKE generated file: DO NOT EDIT!\n"
-                   << "# Generated by CMake Version "
-                   << cmVersion::GetMajorVersion() << "."
-                   << cmVersion::GetMinorVersion() << "\n";
+  cmsys::ofstream verifyStampFile(stampFile.c_str());
+  if (!verifyStampFile) {
+    cmSystemTools::Error("Unable to open verification stamp file for write. " +
+                         stampFile);
+    return false;
+  }
+  verifyStampFile << "# This file is generated by CMake for checking of the "
+                     "VerifyGlobs.json file\n";
+  this->VerifyData = dataFile;
+  this->VerifyStamp = stampFile;
+  return true;
+}
 
-  verifyScriptFile << "cmake_policy(SET CMP0009 NEW)\n";
+namespace {
+bool GlobDirectoriesUnchanged(Json::Value const& glob)
+{
+  Json::Value const& directories = glob["directories"];
+  if (!directories.isArray() || directories.empty()) {
+    return false;
+  }
+  for (Json::Value const& directory : directories) {
+    cmFileTime dirTime;
+    if (!dirTime.Load(directory["path"].asString()) ||
+        dirTime.GetTime() != directory["mtime"].asInt64()) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  for (auto const& i : this->Cache) {
-    CacheEntryKey k = std::get<0>(i);
-    CacheEntryValue v = std::get<1>(i);
+bool GlobFilesUnchanged(Json::Value const& glob)
+{
+  bool const recurse = glob["recurse"].asBool();
+  bool const listDirectories = glob["listDirectories"].asBool();
+  std::string const relative = glob["relative"].asString();
 
-    if (!v.Initialized) {
-      continue;
-    }
+  cmsys::Glob g;
+  g.SetRecurse(recurse);
+  g.SetListDirs(listDirectories);
+  g.SetRecurseListDirs(listDirectories);
+  if (glob["followSymlinks"].asBool()) {
+    g.RecurseThroughSymlinksOn();
+  } else {
+    g.RecurseThroughSymlinksOff();
+  }
+  if (!relative.empty()) {
+    g.SetRelative(relative.c_str());
+  }
+  g.FindFiles(glob["expression"].asString());
 
-    verifyScriptFile << "\n";
+  std::vector<std::string>& files = g.GetFiles();
+  std::sort(files.begin(), files.end());
+  files.erase(std::unique(files.begin(), files.end()), files.end());
 
-    for (auto const& bt : v.Backtraces) {
-      verifyScriptFile << "# " << std::get<0>(bt);
-      messenger->PrintBacktraceTitle(verifyScriptFile, std::get<1>(bt));
-      verifyScriptFile << "\n";
+  Json::Value const& oldFiles = glob["files"];
+  if (files.size() != oldFiles.size()) {
+    return false;
+  }
+  Json::ArrayIndex ii = 0;
+  for (std::string const& file : files) {
+    if (file != oldFiles[ii++].asString()) {
+      return false;
     }
+  }
+  return true;
+}
+}
 
-    k.PrintGlobCommand(verifyScriptFile, "NEW_GLOB");
-    verifyScriptFile << "\n";
+bool cmGlobVerificationManager::VerifyGlobs(std::string const& dataFile)
+{
+  Json::Value data;
+  {
+    cmsys::ifstream dataStream(dataFile.c_str(),
+                               std::ios::in | std::ios::binary);
+    Json::Reader reader;
+    if (!dataStream || !reader.parse(dataStream, data, false) ||
+        !data["globs"].isArray()) {
+      cmSystemTools::Error(cmStrCat("-E cmake_verify_globs failed to parse ",
+                                    dataFile,
+                                    reader.getFormattedErrorMessages()));
+      return false;
+    }
+  }
 
-    verifyScriptFile << "set(OLD_GLOB\n";
-    for (const std::string& file : v.Files) {
-      verifyScriptFile << "  \"" << file << "\"\n";
+  // Only globs with a changed directory need to be listed again.
+  std::vector<Json::Value const*> stale;
+  for (Json::Value const& glob : data["globs"]) {
+    if (!GlobDirectoriesUnchanged(glob)) {
+      stale.push_back(&glob);
     }
-    verifyScriptFile << "  )\n";
+  }
 
-    verifyScriptFile << "if(NOT \"${NEW_GLOB}\" STREQUAL \"${OLD_GLOB}\")\n"
-                     << "  message(\"-- GLOB mismatch!\")\n"
-                     << "  file(TOUCH_NOCREATE \"" << stampFile << "\")\n"
-                     << "endif()\n";
+  // The remaining globs are independent of each other, so list them in
+  // parallel and stop as soon as one of them differs.
+#ifndef CMAKE_BOOTSTRAP
+  std::atomic<std::size_t> next(0);
+  std::atomic<bool> mismatch(false);
+  auto worker = [&stale, &next, &mismatch]() {
+    std::size_t i;
+    while (!mismatch && (i = next++) < stale.size()) {
+      if (!GlobFilesUnchanged(*stale[i])) {
+        mismatch = true;
+      }
+    }
+  };
+  std::size_t const threadCount = std::min<std::size_t>(
+    stale.size(), std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<std::thread> threads;
+  for (std::size_t t = 1; t < threadCount; ++t) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread : threads) {
+    thread.join();
   }
-  verifyScriptFile.Close();
+#else
+  bool mismatch = std::any_of(
+    stale.begin(), stale.end(),
+    [](Json::Value const* glob) { return !GlobFilesUnchanged(*glob); });
+#endif
 
-  cmsys::ofstream verifyStampFile(stampFile.c_str());
-  if (!verifyStampFile) {
-    cmSystemTools::Error("Unable to open verification stamp file for write. " +
-                         stampFile);
-    return false;
+  if (mismatch) {
+    std::cerr << "-- GLOB mismatch!\n";
+    cmSystemTools::Touch(data["stamp"].asString(), false);
   }
-  verifyStampFile << "# This file is generated by CMake for checking of the "
-                     "VerifyGlobs.cmake file\n";
-  this->VerifyScript = scriptFile;
-  this->VerifyStamp = stampFile;
   return true;
 }
 
 bool cmGlobVerificationManager::DoWriteVerifyTarget() const
 {
-  return !this->VerifyScript.empty() && !this->VerifyStamp.empty();
+  return !this->VerifyData.empty() && !this->VerifyStamp.empty();
 }
 
 bool cmGlobVerificationManager::CacheEntryKey::operator<(
@@ -155,6 +274,7 @@ void cmGlobVerificationManager::AddCacheEntry(
   CacheEntryValue& value = this->Cache[key];
   if (!value.Initialized) {
     value.Files = entry.Files;
+    value.Directories = entry.Directories;
     value.Initialized = true;
     value.Backtraces.emplace_back(variable, backtrace);
   } else if (value.Initialized && value.Files != entry.Files) {
@@ -194,6 +314,6 @@ std::vector<cmGlobCacheEntry> cmGlobVerificationManager::GetCacheEntries()
 void cmGlobVerificationManager::Reset()
 {
   this->Cache.clear();
-  this->VerifyScript.clear();
+  this->VerifyData.clear();
   this->VerifyStamp.clear();
 }
@@ -10,6 +10,7 @@
 #include <utility>
 #include <vector>
 
+#include "cmFileTime.h"
 #include "cmListFileCache.h"
 
 class cmMessenger;
@@ -18,15 +19,21 @@ struct cmGlobCacheEntry;
 /** \class cmGlobVerificationManager
  * \brief Class for expressing build-time dependencies on glob expressions.
  *
- * Generates a CMake script which verifies glob outputs during prebuild.
+ * Generates a data file for the native verifier which verifies glob
+ * outputs during prebuild.
  *
  */
 class cmGlobVerificationManager
 {
+public:
+  //! Run the native verifier on a data file written by
+  //! SaveVerificationData.  Touches the stamp file if any glob changed.
+  static bool VerifyGlobs(std::string const& dataFile);
+
 protected:
-  //! Save verification script for given makefile.
-  //! Saves to output <path>/<CMakeFilesDirectory>/VerifyGlobs.cmake
-  bool SaveVerificationScript(const std::string& path, cmMessenger* messenger);
+  //! Save verification data for given makefile.
+  //! Saves to output <path>/<CMakeFilesDirectory>/VerifyGlobs.json
+  bool SaveVerificationData(const std::string& path);
 
   //! Add an entry into the glob cache
   void AddCacheEntry(const cmGlobCacheEntry& entry,
@@ -42,8 +49,8 @@ protected:
   //! Check targets should be written in generated build system.
   bool DoWriteVerifyTarget() const;
 
-  //! Get the paths to the generated script and stamp files
-  std::string const& GetVerifyScript() const { return this->VerifyScript; }
+  //! Get the paths to the generated data and stamp files
+  std::string const& GetVerifyData() const { return this->VerifyData; }
   std::string const& GetVerifyStamp() const { return this->VerifyStamp; }
 
 private:
@@ -71,12 +78,13 @@ private:
   {
     bool Initialized = false;
     std::vector<std::string> Files;
+    std::vector<std::pair<std::string, cmFileTime>> Directories;
     std::vector<std::pair<std::string, cmListFileBacktrace>> Backtraces;
   };
 
   using CacheEntryMap = std::map<CacheEntryKey, CacheEntryValue>;
   CacheEntryMap Cache;
-  std::string VerifyScript;
+  std::string VerifyData;
   std::string VerifyStamp;
 
   // Only cmState should be able to add cache values.
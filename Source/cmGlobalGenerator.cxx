@@ -2101,6 +2101,7 @@ void cmGlobalGenerator::ClearGeneratorMembers()
   this->ProjectMap.clear();
   this->RuleHashes.clear();
   this->DirectoryContentMap.clear();
+  this->DirectoryFileIndex.clear();
   this->BinaryDirectories.clear();
   this->GeneratedFiles.clear();
   this->RuntimeDependencySets.clear();
@@ -3643,6 +3644,45 @@ std::set<std::string> const& cmGlobalGenerator::GetDirectoryContent(
   return dc.All;
 }
 
+namespace {
+std::string DirectoryFileIndexName(std::string const& name)
+{
+#if defined(_WIN32) || defined(__APPLE__)
+  // The filesystem is typically case-insensitive.
+  return cmSystemTools::LowerCase(name);
+#else
+  return name;
+#endif
+}
+}
+
+bool cmGlobalGenerator::DirectoryMayContainFile(std::string const& dir,
+                                                std::string const& name)
+{
+  // Names in nested directories, such as framework contents, are not
+  // covered by a listing of the directory itself.
+  if (name.find('/') != std::string::npos) {
+    return true;
+  }
+
+  auto i = this->DirectoryFileIndex.find(dir);
+  if (i == this->DirectoryFileIndex.end()) {
+    std::unordered_set<std::string> names;
+    cmsys::Directory d;
+    if (d.Load(dir)) {
+      unsigned long n = d.GetNumberOfFiles();
+      for (unsigned long j = 0; j < n; ++j) {
+        const char* f = d.GetFile(j);
+        if (strcmp(f, ".") != 0 && strcmp(f, "..") != 0) {
+          names.insert(DirectoryFileIndexName(f));
+        }
+      }
+    }
+    i = this->DirectoryFileIndex.emplace(dir, std::move(names)).first;
+  }
+  return i->second.count(DirectoryFileIndexName(name)) != 0;
+}
+
 void cmGlobalGenerator::AddRuleHash(const std::vector<std::string>& outputs,
                                     std::string const& content)
 {
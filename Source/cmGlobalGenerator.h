@@ -487,6 +487,13 @@ public:
   std::set<std::string> const& GetDirectoryContent(std::string const& dir,
                                                    bool needDisk = true);
 
+  /** Check whether a file may exist on disk in a directory.  Each
+      directory is listed at most once per generation step, so a false
+      result avoids a filesystem query.  A true result must still be
+      confirmed by checking the file itself.  */
+  bool DirectoryMayContainFile(std::string const& dir,
+                               std::string const& name);
+
   void IndexTarget(cmTarget* t);
   void IndexGeneratorTarget(cmGeneratorTarget* gt);
 
@@ -896,6 +903,10 @@ private:
   };
   std::map<std::string, DirectoryContent> DirectoryContentMap;
 
+  // Names of files on disk in directories checked for conflicts.
+  std::unordered_map<std::string, std::unordered_set<std::string>>
+    DirectoryFileIndex;
+
   // Set of binary directories on disk.
   std::set<std::string> BinaryDirectories;
 
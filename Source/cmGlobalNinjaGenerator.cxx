@@ -276,7 +276,10 @@ void cmGlobalNinjaGenerator::WriteBuild(std::ostream& os,
     }
 
     // Write the rule.
-    buildStr = cmStrCat(buildStr, ": ", build.Rule);
+    auto const alias = this->RuleAliases.find(build.Rule);
+    buildStr =
+      cmStrCat(buildStr, ": ",
+               alias != this->RuleAliases.end() ? alias->second : build.Rule);
   }
 
   std::string arguments;
@@ -1047,6 +1050,21 @@ void cmGlobalNinjaGenerator::AddRule(cmNinjaRule const& rule)
   }
   // Store command length
   this->RuleCmdLength[rule.Name] = static_cast<int>(rule.Command.size());
+  // Multi-config generators add the same rule once per configuration.
+  // Refer to an identical rule that was already written instead.
+  if (this->IsMultiConfig()) {
+    std::string content =
+      cmStrCat(rule.Command, '\0', rule.Description, '\0', rule.DepFile,
+               '\0', rule.DepType, '\0', rule.RspFile, '\0',
+               rule.RspContent, '\0', rule.Restat, '\0',
+               rule.Generator ? '1' : '0');
+    auto const inserted =
+      this->RuleNamesByContent.emplace(std::move(content), rule.Name);
+    if (!inserted.second) {
+      this->RuleAliases.emplace(rule.Name, inserted.first->second);
+      return;
+    }
+  }
   // Write rule
   cmGlobalNinjaGenerator::WriteRule(*this->RulesFileStream, rule);
 }
@@ -1990,8 +2008,8 @@ void cmGlobalNinjaGenerator::WriteTargetRebuildManifest(std::ostream& os)
     {
       cmNinjaRule rule("VERIFY_GLOBS");
       rule.Command =
-        cmStrCat(this->CMakeCmd(), " -P ",
-                 lg->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
+        cmStrCat(this->CMakeCmd(), " -E cmake_verify_globs ",
+                 lg->ConvertToOutputFormat(cm->GetGlobVerifyData(),
                                            cmOutputConverter::SHELL));
       rule.Description = "Re-checking globbed directories...";
       rule.Comment = "Rule for re-checking globbed directories.";
@@ -2002,12 +2020,12 @@ void cmGlobalNinjaGenerator::WriteTargetRebuildManifest(std::ostream& os)
     cmNinjaBuild phonyBuild("phony");
     phonyBuild.Comment = "Phony target to force glob verification run.";
     phonyBuild.Outputs.push_back(
-      cmStrCat(cm->GetGlobVerifyScript(), "_force"));
+      cmStrCat(cm->GetGlobVerifyData(), "_force"));
     this->WriteBuild(os, phonyBuild);
 
     reBuild.Variables["restat"] = "1";
-    std::string const verifyScriptFile =
-      this->NinjaOutputPath(cm->GetGlobVerifyScript());
+    std::string const verifyDataFile =
+      this->NinjaOutputPath(cm->GetGlobVerifyData());
     std::string const verifyStampFile =
       this->NinjaOutputPath(cm->GetGlobVerifyStamp());
     {
@@ -2020,7 +2038,7 @@ void cmGlobalNinjaGenerator::WriteTargetRebuildManifest(std::ostream& os)
       this->WriteBuild(os, vgBuild);
     }
     reBuild.Variables.erase("restat");
-    reBuild.ImplicitDeps.push_back(verifyScriptFile);
+    reBuild.ImplicitDeps.push_back(verifyDataFile);
     reBuild.ExplicitDeps.push_back(verifyStampFile);
   } else if (!this->SupportsManifestRestat() &&
              cm->DoWriteGlobVerifyTarget()) {
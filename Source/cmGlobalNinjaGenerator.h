@@ -310,6 +310,8 @@ public:
    * Add a rule to the generated build system.
    * Call WriteRule() behind the scene but perform some check before like:
    * - Do not add twice the same rule.
+   * - In multi-config builds, share the definition of a rule that is
+   *   identical to one already written under another name.
    */
   void AddRule(cmNinjaRule const& rule);
 
@@ -560,6 +562,13 @@ private:
   /// Length of rule command, used by rsp file evaluation
   std::unordered_map<std::string, int> RuleCmdLength;
 
+  /// Map from the content of a rule to the name it was written under.
+  std::unordered_map<std::string, std::string> RuleNamesByContent;
+
+  /// Map from the name of a rule that was not written because an identical
+  /// rule exists to the name of that rule.
+  std::unordered_map<std::string, std::string> RuleAliases;
+
   bool UsingGCCOnWindows = false;
 
   /// The set of custom command outputs we have seen.
@@ -254,6 +254,9 @@ void cmGlobalUnixMakefileGenerator3::WriteMainCMakefile()
   std::string makefileName =
     cmStrCat(this->GetCMakeInstance()->GetHomeOutputDirectory(), "/Makefile");
 
+  // Content of the check file written next to the cmake file.
+  std::string checkContent;
+
   {
     // get a local generator for some useful methods
     auto& lg = cm::static_reference_cast<cmLocalUnixMakefileGenerator3>(
@@ -277,7 +280,7 @@ void cmGlobalUnixMakefileGenerator3::WriteMainCMakefile()
 
   cmake* cm = this->GetCMakeInstance();
   if (cm->DoWriteGlobVerifyTarget()) {
-    lfiles.push_back(cm->GetGlobVerifyScript());
+    lfiles.push_back(cm->GetGlobVerifyData());
     lfiles.push_back(cm->GetGlobVerifyStamp());
   }
 
@@ -298,8 +301,11 @@ void cmGlobalUnixMakefileGenerator3::WriteMainCMakefile()
       << "# The top level Makefile was generated from the following files:\n"
       << "set(CMAKE_MAKEFILE_DEPENDS\n"
       << "  \"CMakeCache.txt\"\n";
+    checkContent += "D CMakeCache.txt\n";
     for (std::string const& f : lfiles) {
-      cmakefileStream << "  \"" << lg.MaybeRelativeToCurBinDir(f) << "\"\n";
+      std::string const dep = lg.MaybeRelativeToCurBinDir(f);
+      cmakefileStream << "  \"" << dep << "\"\n";
+      checkContent += cmStrCat("D ", dep, '\n');
     }
     cmakefileStream << "  )\n\n";
 
@@ -315,6 +321,9 @@ void cmGlobalUnixMakefileGenerator3::WriteMainCMakefile()
                     << "\"\n"
                     << "  \"" << lg.MaybeRelativeToCurBinDir(check) << "\"\n";
     cmakefileStream << "  )\n\n";
+    checkContent +=
+      cmStrCat("O ", lg.MaybeRelativeToCurBinDir(makefileName), "\nO ",
+               lg.MaybeRelativeToCurBinDir(check), '\n');
 
     // CMake must rerun if a byproduct is missing.
     cmakefileStream << "# Byproducts of CMake generate step:\n"
@@ -325,19 +334,32 @@ void cmGlobalUnixMakefileGenerator3::WriteMainCMakefile()
     for (const auto& localGen : this->LocalGenerators) {
       for (std::string const& outfile :
            localGen->GetMakefile()->GetOutputFiles()) {
-        cmakefileStream << "  \"" << lg.MaybeRelativeToTopBinDir(outfile)
-                        << "\"\n";
+        std::string const product = lg.MaybeRelativeToTopBinDir(outfile);
+        cmakefileStream << "  \"" << product << "\"\n";
+        checkContent += cmStrCat("P ", product, '\n');
       }
-      tmpStr = cmStrCat(localGen->GetCurrentBinaryDirectory(),
-                        "/CMakeFiles/CMakeDirectoryInformation.cmake");
-      cmakefileStream << "  \"" << localGen->MaybeRelativeToTopBinDir(tmpStr)
-                      << "\"\n";
+      tmpStr = localGen->MaybeRelativeToTopBinDir(
+        cmStrCat(localGen->GetCurrentBinaryDirectory(),
+                 "/CMakeFiles/CMakeDirectoryInformation.cmake"));
+      cmakefileStream << "  \"" << tmpStr << "\"\n";
+      checkContent += cmStrCat("P ", tmpStr, '\n');
     }
     cmakefileStream << "  )\n\n";
   }
 
   this->WriteMainCMakefileLanguageRules(cmakefileStream,
                                         this->LocalGenerators);
+  cmakefileStream.Close();
+
+  // Save the products, dependencies, and outputs once more in a plain
+  // format that the check-build-system step reads without evaluating
+  // the above file as a CMake script.  Write it after the above file
+  // so that it is not older than the latter.
+  cmGeneratedFileStream checkStream(cmStrCat(cmakefileName, ".check"));
+  checkStream << "# CMAKE generated file: DO NOT EDIT!\n"
+              << "# Products (P), dependencies (D) and outputs (O) of the "
+                 "generate step.\n"
+              << checkContent;
 }
 
 void cmGlobalUnixMakefileGenerator3::WriteMainCMakefileLanguageRules(
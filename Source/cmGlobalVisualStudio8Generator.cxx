@@ -297,7 +297,8 @@ bool cmGlobalVisualStudio8Generator::AddCheckTarget()
     cmake* cm = this->GetCMakeInstance();
     if (cm->DoWriteGlobVerifyTarget()) {
       cmCustomCommandLines verifyCommandLines = cmMakeSingleCommandLine(
-        { cmSystemTools::GetCMakeCommand(), "-P", cm->GetGlobVerifyScript() });
+        { cmSystemTools::GetCMakeCommand(), "-E", "cmake_verify_globs",
+          cm->GetGlobVerifyData() });
       std::vector<std::string> byproducts;
       byproducts.push_back(cm->GetGlobVerifyStamp());
 
@@ -769,8 +769,8 @@ void cmGlobalXCodeGenerator::CreateReRunCMakeFile(
                       "VERIFY_GLOBS:\n"
                       "\t"
                    << ConvertToMakefilePath(cmSystemTools::GetCMakeCommand())
-                   << " -P "
-                   << ConvertToMakefilePath(cm->GetGlobVerifyScript())
+                   << " -E cmake_verify_globs "
+                   << ConvertToMakefilePath(cm->GetGlobVerifyData())
                    << "\n\n";
   }
 
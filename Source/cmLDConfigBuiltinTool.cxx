@@ -0,0 +1,131 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+
+#include "cmLDConfigBuiltinTool.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <unordered_set>
+#include <utility>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmMakefile.h"
+#include "cmRuntimeDependencyArchive.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+namespace {
+// Layout of the glibc cache file, see glibc's sysdeps/generic/dl-cache.h.
+// The old format is optionally followed by the new format, which is
+// aligned to 8 bytes.  String offsets in new format entries are relative
+// to the beginning of the new format header.
+char const OldMagic[] = "ld.so-1.7.0";
+std::size_t const OldHeaderSize = 16;  // magic[11], nlibs
+std::size_t const OldEntrySize = 12;   // flags, key, value
+char const NewMagic[] = "glibc-ld.so.cache1.1";
+std::size_t const NewHeaderSize = 48;  // magic[17], version[3], ...
+std::size_t const NewNLibsOffset = 20; // after magic and version
+std::size_t const NewEntrySize = 24;   // flags, key, value, os, hwcap
+std::size_t const NewEntryKeyOffset = 4;
+std::size_t const NewEntryValueOffset = 8;
+
+std::uint32_t ReadUInt32(std::string const& data, std::size_t pos)
+{
+  std::uint32_t value;
+  std::memcpy(&value, data.data() + pos, sizeof(value));
+  return value;
+}
+
+bool ReadString(std::string const& data, std::size_t pos, std::string& str)
+{
+  if (pos >= data.size()) {
+    return false;
+  }
+  std::size_t end = data.find('\0', pos);
+  if (end == std::string::npos) {
+    return false;
+  }
+  str = data.substr(pos, end - pos);
+  return true;
+}
+}
+
+cmLDConfigBuiltinTool::cmLDConfigBuiltinTool(
+  cmRuntimeDependencyArchive* archive)
+  : cmLDConfigTool(archive)
+{
+}
+
+bool cmLDConfigBuiltinTool::GetLDConfigPaths(std::vector<std::string>& paths)
+{
+  // Like CMAKE_LDCONFIG_COMMAND, this is an undocumented internal
+  // variable for testing with an alternate cache file.
+  std::string cachePath =
+    this->Archive->GetMakefile()->GetSafeDefinition("CMAKE_LDCONFIG_CACHE");
+  if (cachePath.empty()) {
+    cachePath = "/etc/ld.so.cache";
+  }
+
+  cmsys::ifstream fin(cachePath.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    this->Archive->SetError(cmStrCat("Could not open ", cachePath));
+    return false;
+  }
+  std::string data{ std::istreambuf_iterator<char>(fin),
+                    std::istreambuf_iterator<char>() };
+
+  if (!ParseCache(data, paths, this->Libraries)) {
+    this->Archive->SetError(
+      cmStrCat("Failed to parse dynamic loader cache ", cachePath));
+    return false;
+  }
+  return true;
+}
+
+bool cmLDConfigBuiltinTool::ParseCache(std::string const& data,
+                                       std::vector<std::string>& paths,
+                                       LibraryMap& libraries)
+{
+  // Find the new format header, skipping the old format if present.
+  std::size_t base = 0;
+  if (data.compare(0, sizeof(OldMagic) - 1, OldMagic) == 0) {
+    if (data.size() < OldHeaderSize) {
+      return false;
+    }
+    std::uint32_t nlibs = ReadUInt32(data, OldHeaderSize - 4);
+    base = OldHeaderSize + std::size_t(nlibs) * OldEntrySize;
+    base = (base + 7) & ~std::size_t(7);
+  }
+  if (base > data.size() ||
+      data.compare(base, sizeof(NewMagic) - 1, NewMagic) != 0 ||
+      data.size() - base < NewHeaderSize) {
+    return false;
+  }
+
+  std::uint32_t nlibs = ReadUInt32(data, base + NewNLibsOffset);
+  if ((data.size() - base - NewHeaderSize) / NewEntrySize < nlibs) {
+    return false;
+  }
+
+  std::unordered_set<std::string> seen;
+  for (std::uint32_t i = 0; i < nlibs; ++i) {
+    std::size_t entry = base + NewHeaderSize + i * NewEntrySize;
+    std::string name;
+    std::string path;
+    if (!ReadString(data, base + ReadUInt32(data, entry + NewEntryKeyOffset),
+                    name) ||
+        !ReadString(data,
+                    base + ReadUInt32(data, entry + NewEntryValueOffset),
+                    path)) {
+      return false;
+    }
+    std::string dir = cmSystemTools::GetFilenamePath(path);
+    if (!dir.empty() && seen.insert(dir).second) {
+      paths.push_back(std::move(dir));
+    }
+    libraries[name].push_back(std::move(path));
+  }
+  return true;
+}
@@ -0,0 +1,47 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cmLDConfigTool.h"
+
+class cmRuntimeDependencyArchive;
+
+/** \class cmLDConfigBuiltinTool
+ * \brief Read the dynamic loader search directories from ld.so.cache
+ *
+ * This reads the cache file written by ldconfig directly instead of
+ * running "ldconfig -v".  The cache maps each soname to the path
+ * ldconfig chose for it, which is how the dynamic loader resolves
+ * dependencies not found through RPATH or RUNPATH.  The directories
+ * are reported in the order in which they first appear in the cache,
+ * which is sorted by library name rather than by ldconfig's configured
+ * order, so they are only a fallback for sonames missing from it.
+ */
+class cmLDConfigBuiltinTool : public cmLDConfigTool
+{
+public:
+  cmLDConfigBuiltinTool(cmRuntimeDependencyArchive* archive);
+
+  using LibraryMap =
+    std::unordered_map<std::string, std::vector<std::string>>;
+
+  bool GetLDConfigPaths(std::vector<std::string>& paths) override;
+
+  /** Paths of the cache entries for each soname, in cache order.
+      Available after a successful GetLDConfigPaths.  */
+  LibraryMap const& GetLibraries() const { return this->Libraries; }
+
+  /** Parse the contents of an ld.so.cache file.  Returns false if the
+      data are not in a known format.  */
+  static bool ParseCache(std::string const& data,
+                         std::vector<std::string>& paths,
+                         LibraryMap& libraries);
+
+private:
+  LibraryMap Libraries;
+};
@@ -821,8 +821,8 @@ void cmLocalUnixMakefileGenerator3::WriteSpecialTargetsBottom(
     cmake* cm = this->GlobalGenerator->GetCMakeInstance();
     if (cm->DoWriteGlobVerifyTarget()) {
       std::string rescanRule =
-        cmStrCat("$(CMAKE_COMMAND) -P ",
-                 this->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
+        cmStrCat("$(CMAKE_COMMAND) -E cmake_verify_globs ",
+                 this->ConvertToOutputFormat(cm->GetGlobVerifyData(),
                                              cmOutputConverter::SHELL));
       commands.push_back(rescanRule);
     }
@@ -1822,8 +1822,8 @@ void cmLocalUnixMakefileGenerator3::WriteLocalAllRules(
     cmake* cm = this->GlobalGenerator->GetCMakeInstance();
     if (cm->DoWriteGlobVerifyTarget()) {
       std::string rescanRule =
-        cmStrCat("$(CMAKE_COMMAND) -P ",
-                 this->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
+        cmStrCat("$(CMAKE_COMMAND) -E cmake_verify_globs ",
+                 this->ConvertToOutputFormat(cm->GetGlobVerifyData(),
                                              cmOutputConverter::SHELL));
       commands.push_back(rescanRule);
     }
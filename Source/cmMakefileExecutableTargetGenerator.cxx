@@ -104,16 +104,14 @@ void cmMakefileExecutableTargetGenerator::WriteDeviceExecutableRule(
 
   this->NumberOfProgressActions++;
   if (!this->NoRuleMessages) {
-    cmLocalUnixMakefileGenerator3::EchoProgress progress;
-    this->MakeEchoProgress(progress);
     // Add the link message.
     std::string buildEcho = cmStrCat(
       "Linking CUDA device code ",
       this->LocalGenerator->ConvertToOutputFormat(
         this->LocalGenerator->MaybeRelativeToCurBinDir(this->DeviceLinkObject),
         cmOutputConverter::SHELL));
-    this->LocalGenerator->AppendEcho(
-      commands, buildEcho, cmLocalUnixMakefileGenerator3::EchoLink, &progress);
+    this->AppendProgressEcho(commands, buildEcho,
+                             cmLocalUnixMakefileGenerator3::EchoLink);
   }
 
   if (this->Makefile->GetSafeDefinition("CMAKE_CUDA_COMPILER_ID") == "Clang") {
@@ -355,13 +353,11 @@ void cmMakefileExecutableTargetGenerator::WriteExecutableRule(bool relink)
 
   this->NumberOfProgressActions++;
   if (!this->NoRuleMessages) {
-    cmLocalUnixMakefileGenerator3::EchoProgress progress;
-    this->MakeEchoProgress(progress);
     // Add the link message.
     std::string buildEcho =
       cmStrCat("Linking ", linkLanguage, " executable ", targetOutPath);
-    this->LocalGenerator->AppendEcho(
-      commands, buildEcho, cmLocalUnixMakefileGenerator3::EchoLink, &progress);
+    this->AppendProgressEcho(commands, buildEcho,
+                             cmLocalUnixMakefileGenerator3::EchoLink);
   }
 
   // Build a list of compiler flags and linker flags.
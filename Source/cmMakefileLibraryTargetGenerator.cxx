@@ -261,16 +261,14 @@ void cmMakefileLibraryTargetGenerator::WriteDeviceLibraryRules(
 
   this->NumberOfProgressActions++;
   if (!this->NoRuleMessages) {
-    cmLocalUnixMakefileGenerator3::EchoProgress progress;
-    this->MakeEchoProgress(progress);
     // Add the link message.
     std::string buildEcho = cmStrCat(
       "Linking CUDA device code ",
       this->LocalGenerator->ConvertToOutputFormat(
         this->LocalGenerator->MaybeRelativeToCurBinDir(this->DeviceLinkObject),
         cmOutputConverter::SHELL));
-    this->LocalGenerator->AppendEcho(
-      commands, buildEcho, cmLocalUnixMakefileGenerator3::EchoLink, &progress);
+    this->AppendProgressEcho(commands, buildEcho,
+                             cmLocalUnixMakefileGenerator3::EchoLink);
   }
 
   if (this->Makefile->GetSafeDefinition("CMAKE_CUDA_COMPILER_ID") == "Clang") {
@@ -555,8 +553,6 @@ void cmMakefileLibraryTargetGenerator::WriteLibraryRules(
 
   this->NumberOfProgressActions++;
   if (!this->NoRuleMessages) {
-    cmLocalUnixMakefileGenerator3::EchoProgress progress;
-    this->MakeEchoProgress(progress);
     // Add the link message.
     std::string buildEcho = cmStrCat("Linking ", linkLanguage);
     switch (this->GeneratorTarget->GetType()) {
@@ -577,8 +573,8 @@ void cmMakefileLibraryTargetGenerator::WriteLibraryRules(
         break;
     }
     buildEcho += targetOutPath;
-    this->LocalGenerator->AppendEcho(
-      commands, buildEcho, cmLocalUnixMakefileGenerator3::EchoLink, &progress);
+    this->AppendProgressEcho(commands, buildEcho,
+                             cmLocalUnixMakefileGenerator3::EchoLink);
   }
 
   // Clean files associated with this library.
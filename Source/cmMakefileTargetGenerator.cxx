@@ -20,6 +20,7 @@
 #include "cm_codecvt_Encoding.hxx"
 
 #include "cmComputeLinkInformation.h"
+#include "cmCryptoHash.h"
 #include "cmCustomCommand.h"
 #include "cmCustomCommandGenerator.h"
 #include "cmFileSet.h"
@@ -67,6 +68,11 @@ cmMakefileTargetGenerator::cmMakefileTargetGenerator(cmGeneratorTarget* target)
         cm->GetState()->GetGlobalProperty("RULE_MESSAGES")) {
     this->NoRuleMessages = ruleStatus.IsOff();
   }
+  this->NoRuleProgress = false;
+  if (cmValue progressStatus =
+        cm->GetState()->GetGlobalProperty("RULE_PROGRESS")) {
+    this->NoRuleProgress = progressStatus.IsOff();
+  }
   switch (this->GeneratorTarget->GetPolicyStatusCMP0113()) {
     case cmPolicies::WARN:
       CM_FALLTHROUGH;
@@ -552,9 +558,11 @@ void cmMakefileTargetGenerator::WriteTargetLanguageFlags()
   // things rebuild
   for (std::string const& language : languages) {
     std::string compiler = cmStrCat("CMAKE_", language, "_COMPILER");
-    *this->FlagFileStream << "# compile " << language << " with "
-                          << this->Makefile->GetSafeDefinition(compiler)
-                          << "\n";
+    std::string compileWith =
+      cmStrCat("# compile ", language, " with ",
+               this->Makefile->GetSafeDefinition(compiler), '\n');
+    *this->FlagFileStream << compileWith;
+    this->LanguageFlagsContent[language] = std::move(compileWith);
   }
 
   bool const escapeOctothorpe = this->GlobalGenerator->CanEscapeOctothorpe();
@@ -567,8 +575,9 @@ void cmMakefileTargetGenerator::WriteTargetLanguageFlags()
       cmSystemTools::ReplaceString(defines, "#", "\\#");
       cmSystemTools::ReplaceString(includes, "#", "\\#");
     }
-    *this->FlagFileStream << language << "_DEFINES = " << defines << "\n\n";
-    *this->FlagFileStream << language << "_INCLUDES = " << includes << "\n\n";
+    std::ostringstream languageFlags;
+    languageFlags << language << "_DEFINES = " << defines << "\n\n";
+    languageFlags << language << "_INCLUDES = " << includes << "\n\n";
 
     std::vector<std::string> architectures =
       this->GeneratorTarget->GetAppleArchs(this->GetConfigName(), language);
@@ -580,9 +589,11 @@ void cmMakefileTargetGenerator::WriteTargetLanguageFlags()
       if (escapeOctothorpe) {
         cmSystemTools::ReplaceString(flags, "#", "\\#");
       }
-      *this->FlagFileStream << language << "_FLAGS" << arch << " = " << flags
-                            << "\n\n";
+      languageFlags << language << "_FLAGS" << arch << " = " << flags
+                    << "\n\n";
     }
+    *this->FlagFileStream << languageFlags.str();
+    this->LanguageFlagsContent[language] += languageFlags.str();
   }
 }
 
@@ -689,8 +700,11 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
   this->LocalGenerator->AddImplicitDepends(this->GeneratorTarget, lang,
                                            objFullPath, srcFullPath, scanner);
 
-  this->LocalGenerator->AppendRuleDepend(depends,
-                                         this->FlagFileNameFull.c_str());
+  // Depend on a hash of the flags used for this object instead of the
+  // whole flags.make so that changing the flags of other sources or
+  // languages in the target does not rebuild it.
+  std::string const flagsHashFile = cmStrCat(objFullPath, ".flags");
+  this->LocalGenerator->AppendRuleDepend(depends, flagsHashFile.c_str());
   this->LocalGenerator->AppendRuleDepends(depends,
                                           this->FlagFileDepends[lang]);
 
@@ -787,14 +801,15 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
   }
 
   // Add flags from source file properties.
+  std::ostringstream customFlags;
   const std::string COMPILE_FLAGS("COMPILE_FLAGS");
   if (cmValue cflags = source.GetProperty(COMPILE_FLAGS)) {
     const std::string& evaluatedFlags =
       genexInterpreter.Evaluate(*cflags, COMPILE_FLAGS);
     this->LocalGenerator->AppendFlags(flags, evaluatedFlags);
-    *this->FlagFileStream << "# Custom flags: " << relativeObj
-                          << "_FLAGS = " << evaluatedFlags << "\n"
-                          << "\n";
+    customFlags << "# Custom flags: " << relativeObj << "_FLAGS = "
+                << evaluatedFlags << "\n"
+                << "\n";
   }
 
   const std::string COMPILE_OPTIONS("COMPILE_OPTIONS");
@@ -802,9 +817,9 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
     const std::string& evaluatedOptions =
       genexInterpreter.Evaluate(*coptions, COMPILE_OPTIONS);
     this->LocalGenerator->AppendCompileOptions(flags, evaluatedOptions);
-    *this->FlagFileStream << "# Custom options: " << relativeObj
-                          << "_OPTIONS = " << evaluatedOptions << "\n"
-                          << "\n";
+    customFlags << "# Custom options: " << relativeObj << "_OPTIONS = "
+                << evaluatedOptions << "\n"
+                << "\n";
   }
 
   // Add precompile headers compile options.
@@ -823,9 +838,9 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
       genexInterpreter.Evaluate(pchOptions, COMPILE_OPTIONS);
 
     this->LocalGenerator->AppendCompileOptions(flags, evaluatedFlags);
-    *this->FlagFileStream << "# PCH options: " << relativeObj
-                          << "_OPTIONS = " << evaluatedFlags << "\n"
-                          << "\n";
+    customFlags << "# PCH options: " << relativeObj << "_OPTIONS = "
+                << evaluatedFlags << "\n"
+                << "\n";
   }
 
   // Add include directories from source file properties.
@@ -837,10 +852,9 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
       genexInterpreter.Evaluate(*cincludes, INCLUDE_DIRECTORIES);
     this->LocalGenerator->AppendIncludeDirectories(includes, evaluatedIncludes,
                                                    source);
-    *this->FlagFileStream << "# Custom include directories: " << relativeObj
-                          << "_INCLUDE_DIRECTORIES = " << evaluatedIncludes
-                          << "\n"
-                          << "\n";
+    customFlags << "# Custom include directories: " << relativeObj
+                << "_INCLUDE_DIRECTORIES = " << evaluatedIncludes << "\n"
+                << "\n";
   }
 
   // Add language-specific defines.
@@ -852,9 +866,9 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
     const std::string& evaluatedDefs =
       genexInterpreter.Evaluate(*compile_defs, COMPILE_DEFINITIONS);
     this->LocalGenerator->AppendDefines(defines, evaluatedDefs);
-    *this->FlagFileStream << "# Custom defines: " << relativeObj
-                          << "_DEFINES = " << evaluatedDefs << "\n"
-                          << "\n";
+    customFlags << "# Custom defines: " << relativeObj << "_DEFINES = "
+                << evaluatedDefs << "\n"
+                << "\n";
   }
   std::string const defPropName =
     cmStrCat("COMPILE_DEFINITIONS_", configUpper);
@@ -862,9 +876,22 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
     const std::string& evaluatedDefs =
       genexInterpreter.Evaluate(*config_compile_defs, COMPILE_DEFINITIONS);
     this->LocalGenerator->AppendDefines(defines, evaluatedDefs);
-    *this->FlagFileStream << "# Custom defines: " << relativeObj << "_DEFINES_"
-                          << configUpper << " = " << evaluatedDefs << "\n"
-                          << "\n";
+    customFlags << "# Custom defines: " << relativeObj << "_DEFINES_"
+                << configUpper << " = " << evaluatedDefs << "\n"
+                << "\n";
+  }
+
+  // Record the flags of this object and their hash.
+  *this->FlagFileStream << customFlags.str();
+  {
+    cmCryptoHash hasher(cmCryptoHash::AlgoSHA256);
+    cmGeneratedFileStream flagsHashStream(flagsHashFile);
+    flagsHashStream.SetCopyIfDifferent(true);
+    flagsHashStream << "# Hash of the flags used to compile " << relativeObj
+                    << "\n"
+                    << hasher.HashString(cmStrCat(
+                         this->LanguageFlagsContent[lang], customFlags.str()))
+                    << "\n";
   }
 
   // Get the output paths for source and object files.
@@ -879,13 +906,10 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
   this->NumberOfProgressActions++;
 
   if (!this->NoRuleMessages) {
-    cmLocalUnixMakefileGenerator3::EchoProgress progress;
-    this->MakeEchoProgress(progress);
     std::string buildEcho =
       cmStrCat("Building ", lang, " object ", relativeObj);
-    this->LocalGenerator->AppendEcho(commands, buildEcho,
-                                     cmLocalUnixMakefileGenerator3::EchoBuild,
-                                     &progress);
+    this->AppendProgressEcho(commands, buildEcho,
+                             cmLocalUnixMakefileGenerator3::EchoBuild);
   }
 
   std::string targetOutPathReal;
@@ -1731,11 +1755,8 @@ void cmMakefileTargetGenerator::GenerateCustomRuleFile(
     // add in a progress call if needed
     this->NumberOfProgressActions++;
     if (!this->NoRuleMessages) {
-      cmLocalUnixMakefileGenerator3::EchoProgress progress;
-      this->MakeEchoProgress(progress);
-      this->LocalGenerator->AppendEcho(
-        commands, comment, cmLocalUnixMakefileGenerator3::EchoGenerate,
-        &progress);
+      this->AppendProgressEcho(commands, comment,
+                               cmLocalUnixMakefileGenerator3::EchoGenerate);
     }
   }
 
@@ -1815,6 +1836,22 @@ void cmMakefileTargetGenerator::MakeEchoProgress(
   progress.Arg = progressArg.str();
 }
 
+void cmMakefileTargetGenerator::AppendProgressEcho(
+  std::vector<std::string>& commands, std::string const& text,
+  cmLocalUnixMakefileGenerator3::EchoColor color)
+{
+  if (this->NoRuleProgress) {
+    // Use the native echo command so no CMake process runs for the message.
+    // Progress is reported when the whole target completes.
+    this->LocalGenerator->AppendEcho(commands, text,
+                                     cmLocalUnixMakefileGenerator3::EchoNormal);
+    return;
+  }
+  cmLocalUnixMakefileGenerator3::EchoProgress progress;
+  this->MakeEchoProgress(progress);
+  this->LocalGenerator->AppendEcho(commands, text, color, &progress);
+}
+
 void cmMakefileTargetGenerator::WriteObjectsVariable(
   std::string& variableName, std::string& variableNameExternal,
   bool useWatcomQuote)
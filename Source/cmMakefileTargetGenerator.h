@@ -124,6 +124,11 @@ protected:
 
   void MakeEchoProgress(cmLocalUnixMakefileGenerator3::EchoProgress&) const;
 
+  // append the message of a rule counted as a progress action
+  void AppendProgressEcho(std::vector<std::string>& commands,
+                          std::string const& text,
+                          cmLocalUnixMakefileGenerator3::EchoColor color);
+
   // write out the variable that lists the objects for this target
   void WriteObjectsVariable(std::string& variableName,
                             std::string& variableNameExternal,
@@ -221,6 +226,7 @@ protected:
   std::string ProgressFileNameFull;
   unsigned long NumberOfProgressActions;
   bool NoRuleMessages;
+  bool NoRuleProgress;
 
   bool CMP0113New = false;
 
@@ -239,6 +245,10 @@ protected:
   };
   std::map<std::string, StringList> FlagFileDepends;
 
+  // the content of flags.make that applies to each language, used to
+  // rebuild objects only when their own flags change
+  std::map<std::string, std::string> LanguageFlagsContent;
+
   // the stream for the info file
   std::string InfoFileNameFull;
   std::unique_ptr<cmGeneratedFileStream> InfoFileStream;
@@ -1637,6 +1637,7 @@ void cmNinjaTargetGenerator::WriteObjectBuildStatement(
     this->addPoolNinjaVariable("JOB_POOL_COMPILE", this->GetGeneratorTarget(),
                                ppBuild.Variables);
 
+    this->ShareCompileVariables(ppBuild.Variables, config, fileConfig);
     this->GetGlobalGenerator()->WriteBuild(this->GetImplFileStream(fileConfig),
                                            ppBuild, commandLineLengthLimit);
 
@@ -1740,6 +1741,7 @@ void cmNinjaTargetGenerator::WriteObjectBuildStatement(
   if (language == "Swift") {
     this->EmitSwiftDependencyInfo(source, config);
   } else {
+    this->ShareCompileVariables(vars, config, fileConfig);
     this->GetGlobalGenerator()->WriteBuild(this->GetImplFileStream(fileConfig),
                                            objBuild, commandLineLengthLimit);
   }
@@ -1761,6 +1763,38 @@ void cmNinjaTargetGenerator::WriteObjectBuildStatement(
   }
 }
 
+void cmNinjaTargetGenerator::ShareCompileVariables(
+  cmNinjaVars& vars, const std::string& config, const std::string& fileConfig)
+{
+  // Targets with many sources repeat the same, possibly very long, flags
+  // on every compile statement.  Once a value is used a second time, write
+  // it to a file-level variable and refer to that from the statements.
+  SharedVariables& shared =
+    this->Configs[config].SharedCompileVariables[fileConfig];
+  for (std::string const name : { "FLAGS", "DEFINES", "INCLUDES" }) {
+    auto const it = vars.find(name);
+    if (it == vars.end() || it->second.empty()) {
+      continue;
+    }
+    auto const inserted =
+      shared.Names.emplace(cmStrCat(name, '=', it->second), std::string());
+    if (inserted.second) {
+      continue;
+    }
+    std::string& sharedName = inserted.first->second;
+    if (sharedName.empty()) {
+      sharedName = cmStrCat(
+        name, "__",
+        cmGlobalNinjaGenerator::EncodeRuleName(this->GeneratorTarget->GetName()),
+        '_', config, fileConfig != config ? cmStrCat('_', fileConfig) : "",
+        '_', ++shared.Count);
+      cmGlobalNinjaGenerator::WriteVariable(this->GetImplFileStream(fileConfig),
+                                            sharedName, it->second);
+    }
+    it->second = cmStrCat("${", sharedName, '}');
+  }
+}
+
 void cmNinjaTargetGenerator::WriteCxxModuleBmiBuildStatement(
   cmSourceFile const* source, const std::string& config,
   const std::string& fileConfig, bool firstForConfig)
@@ -184,6 +184,8 @@ protected:
                                  bool firstForConfig);
   void WriteTargetDependInfo(std::string const& lang,
                              const std::string& config);
+  void ShareCompileVariables(cmNinjaVars& vars, const std::string& config,
+                             const std::string& fileConfig);
 
   void EmitSwiftDependencyInfo(cmSourceFile const* source,
                                const std::string& config);
@@ -256,6 +258,15 @@ private:
     std::string ModuleMapFile;
   };
 
+  struct SharedVariables
+  {
+    // Names of the file-level variables holding compile flags that are
+    // used by more than one build statement, keyed by "<name>=<value>".
+    // An empty name marks a value seen only once so far.
+    std::map<std::string, std::string> Names;
+    unsigned int Count = 0;
+  };
+
   struct ByConfig
   {
     /// List of object files for this target.
@@ -268,6 +279,9 @@ private:
     Json::Value SwiftOutputMap;
     cmNinjaDeps ExtraFiles;
     std::unique_ptr<MacOSXContentGeneratorType> MacOSXContentGenerator;
+    // Shared compile variables by the file configuration they are
+    // written to.
+    std::map<std::string, SharedVariables> SharedCompileVariables;
   };
 
   std::map<std::string, ByConfig> Configs;
@@ -83,9 +83,7 @@ public:
     bool first = true;
     for (std::string const& dir : this->OD->OriginalDirectories) {
       // Check if this directory conflicts with the entry.
-      if (dir != this->Directory &&
-          cmSystemTools::GetRealPath(dir) !=
-            cmSystemTools::GetRealPath(this->Directory) &&
+      if (!this->OD->IsSameDirectory(dir, this->Directory) &&
           this->FindConflict(dir)) {
         // The library will be found in this directory but it is
         // supposed to be found in an implicit search directory.
@@ -120,12 +118,15 @@ protected:
 bool cmOrderDirectoriesConstraint::FileMayConflict(std::string const& dir,
                                                    std::string const& name)
 {
-  // Check if the file exists on disk.
-  std::string file = cmStrCat(dir, '/', name);
-  if (cmSystemTools::FileExists(file, true)) {
-    // The file conflicts only if it is not the same as the original
-    // file due to a symlink or hardlink.
-    return !cmSystemTools::SameFile(this->FullPath, file);
+  // Check if the file exists on disk.  The directory index answers
+  // the common case of no conflict without querying the filesystem.
+  if (this->GlobalGenerator->DirectoryMayContainFile(dir, name)) {
+    std::string file = cmStrCat(dir, '/', name);
+    if (cmSystemTools::FileExists(file, true)) {
+      // The file conflicts only if it is not the same as the original
+      // file due to a symlink or hardlink.
+      return !cmSystemTools::SameFile(this->FullPath, file);
+    }
   }
 
   // Check if the file will be built by cmake.
@@ -554,12 +555,6 @@ bool cmOrderDirectories::IsSameDirectory(std::string const& l,
 
 std::string const& cmOrderDirectories::GetRealPath(std::string const& dir)
 {
-  auto i = this->RealPaths.lower_bound(dir);
-  if (i == this->RealPaths.end() ||
-      this->RealPaths.key_comp()(dir, i->first)) {
-    using value_type = std::map<std::string, std::string>::value_type;
-    i = this->RealPaths.insert(
-      i, value_type(dir, cmSystemTools::GetRealPath(dir)));
-  }
-  return i->second;
+  // The global generator shares resolved paths between targets.
+  return this->GlobalGenerator->GetRealPath(dir);
 }
@@ -89,7 +89,6 @@ private:
   bool IsImplicitDirectory(std::string const& dir);
 
   std::string const& GetRealPath(std::string const& dir);
-  std::map<std::string, std::string> RealPaths;
 
   friend class cmOrderDirectoriesConstraint;
   friend class cmOrderDirectoriesConstraintLibrary;
@@ -81,26 +81,38 @@ void cmProcessTools::LineParser::SetLog(std::ostream* log, const char* prefix)
 bool cmProcessTools::LineParser::ProcessChunk(const char* first, int length)
 {
   const char* last = first + length;
-  for (const char* c = first; c != last; ++c) {
-    if (*c == this->Separator || *c == '\0') {
-      this->LineEnd = *c;
+  const char* c = first;
+  while (c != last) {
+    // Append the run of characters up to the next line end at once.
+    const char* run = c;
+    while (c != last && *c != this->Separator && *c != '\0' &&
+           (*c != '\r' || !this->IgnoreCR)) {
+      ++c;
+    }
+    this->Line.append(run, c - run);
+    if (c == last) {
+      break;
+    }
+    if (*c == '\r') {
+      // Drop this carriage return.
+      ++c;
+      continue;
+    }
 
-      // Log this line.
-      if (this->Log && this->Prefix) {
-        *this->Log << this->Prefix << this->Line << "\n";
-      }
+    this->LineEnd = *c++;
 
-      // Hand this line to the subclass implementation.
-      if (!this->ProcessLine()) {
-        this->Line.clear();
-        return false;
-      }
+    // Log this line.
+    if (this->Log && this->Prefix) {
+      *this->Log << this->Prefix << this->Line << "\n";
+    }
 
+    // Hand this line to the subclass implementation.
+    if (!this->ProcessLine()) {
       this->Line.clear();
-    } else if (*c != '\r' || !this->IgnoreCR) {
-      // Append this character to the line under construction.
-      this->Line.append(1, *c);
+      return false;
     }
+
+    this->Line.clear();
   }
   return true;
 }
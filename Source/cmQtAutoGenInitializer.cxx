@@ -577,6 +577,12 @@ bool cmQtAutoGenInitializer::InitCustomTargets()
       this->ConfigFileNames(this->AutogenTarget.ParseCacheFile,
                             cmStrCat(this->Dir.Info, "/ParseCache"), ".txt");
       this->ConfigFileClean(this->AutogenTarget.ParseCacheFile);
+
+      // Timing file
+      this->ConfigFileNames(this->AutogenTarget.TimingFile,
+                            cmStrCat(this->Dir.Info, "/AutogenTiming"),
+                            ".json");
+      this->ConfigFileClean(this->AutogenTarget.TimingFile);
     }
 
     // Autogen target: Compute user defined dependencies
@@ -1249,6 +1255,9 @@ bool cmQtAutoGenInitializer::InitScanFiles()
       qrc.LockFile = cmStrCat(base, "_Lock.lock");
       qrc.InfoFile = cmStrCat(base, "_Info.json");
       this->ConfigFileNames(qrc.SettingsFile, cmStrCat(base, "_Used"), ".txt");
+      this->ConfigFileNames(qrc.ManifestFile, cmStrCat(base, "_Manifest"),
+                            ".txt");
+      this->ConfigFileClean(qrc.ManifestFile);
     }
     // rcc options
     for (Qrc& qrc : this->Rcc.Qrcs) {
@@ -1855,6 +1864,10 @@ bool cmQtAutoGenInitializer::SetupWriteAutogenInfo()
   info.Set("CMAKE_EXECUTABLE", cmSystemTools::GetCMakeCommand());
   info.SetConfig("SETTINGS_FILE", this->AutogenTarget.SettingsFile);
   info.SetConfig("PARSE_CACHE_FILE", this->AutogenTarget.ParseCacheFile);
+  info.SetConfig("TIMING_FILE", this->AutogenTarget.TimingFile);
+  info.Set("PARSE_CACHE_SHARED_DIR",
+           cmStrCat(this->Makefile->GetHomeOutputDirectory(),
+                    "/CMakeFiles/AutogenParseCache"));
   info.SetConfig("DEP_FILE", this->AutogenTarget.DepFile);
   info.SetConfig("DEP_FILE_RULE_NAME", this->AutogenTarget.DepFileRuleName);
   info.SetArray("CMAKE_LIST_FILES", this->Makefile->GetListFiles());
@@ -1937,6 +1950,9 @@ bool cmQtAutoGenInitializer::SetupWriteAutogenInfo()
       });
     info.SetConfig("MOC_COMPILATION_FILE", this->Moc.CompilationFile);
     info.SetConfig("MOC_PREDEFS_FILE", this->Moc.PredefsFile);
+    info.Set("MOC_PREDEFS_SHARED_DIR",
+             cmStrCat(this->Makefile->GetHomeOutputDirectory(),
+                      "/CMakeFiles/AutogenPredefsCache"));
 
     cmStandardLevelResolver const resolver{ this->Makefile };
     auto const CompileOptionFlag =
@@ -1995,6 +2011,7 @@ bool cmQtAutoGenInitializer::SetupWriteRccInfo()
     // Files
     info.Set("LOCK_FILE", qrc.LockFile);
     info.SetConfig("SETTINGS_FILE", qrc.SettingsFile);
+    info.SetConfig("MANIFEST_FILE", qrc.ManifestFile);
 
     // Directories
     info.Set("CMAKE_SOURCE_DIR", MfDef("CMAKE_SOURCE_DIR"));
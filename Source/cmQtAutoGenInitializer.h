@@ -44,6 +44,7 @@ public:
     std::string QrcPathChecksum;
     std::string InfoFile;
     ConfigString SettingsFile;
+    ConfigString ManifestFile;
     std::string OutputFile;
     bool Generated = false;
     bool Unique = false;
@@ -192,6 +193,7 @@ private:
     std::string InfoFile;
     ConfigString SettingsFile;
     ConfigString ParseCacheFile;
+    ConfigString TimingFile;
     // Dependencies
     bool DependOrigin = false;
     std::set<std::string> DependFiles;
@@ -4,11 +4,14 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <initializer_list>
 #include <limits>
 #include <map>
 #include <mutex>
 #include <set>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -21,6 +24,7 @@
 #include <cmext/algorithm>
 
 #include <cm3p/json/value.h>
+#include <cm3p/json/writer.h>
 
 #include "cmsys/FStream.hxx"
 #include "cmsys/RegularExpression.hxx"
@@ -34,6 +38,7 @@
 #include "cmQtAutoGenerator.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
+#include "cmVersion.h"
 #include "cmWorkerPool.h"
 
 #if defined(__APPLE__)
@@ -119,10 +124,19 @@ public:
     bool ReadFromFile(std::string const& fileName);
     bool WriteToFile(std::string const& fileName);
 
+    //! Entries of the build tree wide cache shared between targets
+    static bool ReadSharedEntry(std::string const& fileName,
+                                std::string const& contentHash, FileT& file);
+    static std::string SharedEntryContent(std::string const& contentHash,
+                                          FileT const& file);
+
     //! Always returns a valid handle
     GetOrInsertT GetOrInsert(std::string const& fileName);
 
   private:
+    static bool ReadEntryLine(std::string const& line, FileT& file);
+    static void WriteEntry(std::ostream& os, FileT const& file);
+
     std::unordered_map<std::string, FileHandleT> Map_;
   };
 
@@ -138,6 +152,9 @@ public:
     std::string FileName;
     cmFileTime FileTime;
     ParseCacheT::FileHandleT ParseData;
+    // Parse result to publish in the shared parse cache
+    std::string SharedParseCacheFile;
+    std::string SharedParseCacheContent;
     std::string BuildPath;
     bool IsHeader = false;
     bool Moc = false;
@@ -184,6 +201,9 @@ public:
     std::string CMakeExecutable;
     cmFileTime CMakeExecutableTime;
     std::string ParseCacheFile;
+    std::string TimingFile;
+    std::string SharedParseCacheDir;
+    std::string SharedParseCacheSettings;
     std::string DepFile;
     std::string DepFileRuleName;
     std::vector<std::string> HeaderExtensions;
@@ -202,6 +222,13 @@ public:
     // -- Sources
     SourceFileMapT Headers;
     SourceFileMapT Sources;
+
+    // -- Timing of the processing stages
+    using ClockT = std::chrono::steady_clock;
+    ClockT::time_point StartTime;
+    ClockT::time_point ParseEndTime;
+    ClockT::time_point ProbeEndTime;
+    ClockT::time_point EndTime;
   };
 
   /** Moc settings.  */
@@ -229,6 +256,7 @@ public:
     std::string Executable;
     std::string CompFileAbs;
     std::string PredefsFileAbs;
+    std::string PredefsSharedDir;
     std::unordered_set<std::string> SkipList;
     std::vector<std::string> IncludePaths;
     std::vector<std::string> Definitions;
@@ -369,6 +397,7 @@ public:
   {
     void Process() override;
     bool Update(std::string* reason) const;
+    bool ReadShared(std::string const& sharedFile, std::string& content);
   };
 
   /** File parse job base class.  */
@@ -382,6 +411,8 @@ public:
 
   protected:
     bool ReadFile();
+    bool ReadSharedParseCache(char kind);
+    void StoreSharedParseCache();
     void CreateKeys(std::vector<IncludeKeyT>& container,
                     std::set<std::string> const& source,
                     std::size_t basePrefixLength);
@@ -574,6 +605,7 @@ private:
   // -- Parse cache
   void ParseCacheRead();
   bool ParseCacheWrite();
+  void TimingWrite();
   // -- Thread processing
   void Abort(bool error);
   // -- Generation
@@ -668,42 +700,52 @@ bool cmQtAutoMocUicT::ParseCacheT::ReadFromFile(std::string const& fileName)
       continue;
     }
 
-    // Bad line or bad file handle
-    if (!fileHandle || (line.size() < 6)) {
-      continue;
-    }
-
-    constexpr std::size_t offset = 5;
-    if (cmHasLiteralPrefix(line, " mmc:")) {
-      fileHandle->Moc.Macro = line.substr(offset);
-      continue;
-    }
-    if (cmHasLiteralPrefix(line, " miu:")) {
-      fileHandle->Moc.Include.Underscore.emplace_back(line.substr(offset),
-                                                      MocUnderscoreLength);
-      continue;
-    }
-    if (cmHasLiteralPrefix(line, " mid:")) {
-      fileHandle->Moc.Include.Dot.emplace_back(line.substr(offset), 0);
-      continue;
-    }
-    if (cmHasLiteralPrefix(line, " mdp:")) {
-      fileHandle->Moc.Depends.emplace_back(line.substr(offset));
-      continue;
-    }
-    if (cmHasLiteralPrefix(line, " uic:")) {
-      fileHandle->Uic.Include.emplace_back(line.substr(offset),
-                                           UiUnderscoreLength);
-      continue;
-    }
-    if (cmHasLiteralPrefix(line, " udp:")) {
-      fileHandle->Uic.Depends.emplace_back(line.substr(offset));
+    // Bad file handle
+    if (!fileHandle) {
       continue;
     }
+    ReadEntryLine(line, *fileHandle);
   }
   return true;
 }
 
+bool cmQtAutoMocUicT::ParseCacheT::ReadEntryLine(std::string const& line,
+                                                 FileT& file)
+{
+  // Bad line
+  if (line.size() < 6) {
+    return false;
+  }
+
+  constexpr std::size_t offset = 5;
+  if (cmHasLiteralPrefix(line, " mmc:")) {
+    file.Moc.Macro = line.substr(offset);
+    return true;
+  }
+  if (cmHasLiteralPrefix(line, " miu:")) {
+    file.Moc.Include.Underscore.emplace_back(line.substr(offset),
+                                             MocUnderscoreLength);
+    return true;
+  }
+  if (cmHasLiteralPrefix(line, " mid:")) {
+    file.Moc.Include.Dot.emplace_back(line.substr(offset), 0);
+    return true;
+  }
+  if (cmHasLiteralPrefix(line, " mdp:")) {
+    file.Moc.Depends.emplace_back(line.substr(offset));
+    return true;
+  }
+  if (cmHasLiteralPrefix(line, " uic:")) {
+    file.Uic.Include.emplace_back(line.substr(offset), UiUnderscoreLength);
+    return true;
+  }
+  if (cmHasLiteralPrefix(line, " udp:")) {
+    file.Uic.Depends.emplace_back(line.substr(offset));
+    return true;
+  }
+  return false;
+}
+
 bool cmQtAutoMocUicT::ParseCacheT::WriteToFile(std::string const& fileName)
 {
   cmGeneratedFileStream ofs(fileName);
@@ -713,27 +755,89 @@ bool cmQtAutoMocUicT::ParseCacheT::WriteToFile(std::string const& fileName)
   ofs << "# Generated by CMake. Changes will be overwritten.\n";
   for (auto const& pair : this->Map_) {
     ofs << pair.first << '\n';
-    FileT const& file = *pair.second;
-    if (!file.Moc.Macro.empty()) {
-      ofs << " mmc:" << file.Moc.Macro << '\n';
-    }
-    for (IncludeKeyT const& item : file.Moc.Include.Underscore) {
-      ofs << " miu:" << item.Key << '\n';
-    }
-    for (IncludeKeyT const& item : file.Moc.Include.Dot) {
-      ofs << " mid:" << item.Key << '\n';
-    }
-    for (std::string const& item : file.Moc.Depends) {
-      ofs << " mdp:" << item << '\n';
-    }
-    for (IncludeKeyT const& item : file.Uic.Include) {
-      ofs << " uic:" << item.Key << '\n';
+    WriteEntry(ofs, *pair.second);
+  }
+  return ofs.Close();
+}
+
+void cmQtAutoMocUicT::ParseCacheT::WriteEntry(std::ostream& os,
+                                              FileT const& file)
+{
+  if (!file.Moc.Macro.empty()) {
+    os << " mmc:" << file.Moc.Macro << '\n';
+  }
+  for (IncludeKeyT const& item : file.Moc.Include.Underscore) {
+    os << " miu:" << item.Key << '\n';
+  }
+  for (IncludeKeyT const& item : file.Moc.Include.Dot) {
+    os << " mid:" << item.Key << '\n';
+  }
+  for (std::string const& item : file.Moc.Depends) {
+    os << " mdp:" << item << '\n';
+  }
+  for (IncludeKeyT const& item : file.Uic.Include) {
+    os << " uic:" << item.Key << '\n';
+  }
+  for (std::string const& item : file.Uic.Depends) {
+    os << " udp:" << item << '\n';
+  }
+}
+
+bool cmQtAutoMocUicT::ParseCacheT::ReadSharedEntry(
+  std::string const& fileName, std::string const& contentHash, FileT& file)
+{
+  cmsys::ifstream fin(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return false;
+  }
+  // The first line holds the hash of the parsed file content
+  std::string line;
+  if (!std::getline(fin, line) || line != contentHash) {
+    return false;
+  }
+  FileT entry;
+  while (std::getline(fin, line)) {
+    ReadEntryLine(line, entry);
+  }
+  file = std::move(entry);
+  return true;
+}
+
+std::string cmQtAutoMocUicT::ParseCacheT::SharedEntryContent(
+  std::string const& contentHash, FileT const& file)
+{
+  std::ostringstream os;
+  os << contentHash << '\n';
+  WriteEntry(os, file);
+  return os.str();
+}
+
+/** Write a file of a cache shared between AUTOGEN processes.  */
+bool WriteSharedCacheFile(std::string const& fileName,
+                          std::string const& content)
+{
+  // Write to a temporary file and move it into place so that concurrent
+  // readers in other AUTOGEN processes never see a partial entry.
+  std::string const tmpFile =
+    cmStrCat(fileName, '.', cmSystemTools::RandomSeed(), ".tmp");
+  {
+    cmsys::ofstream ofs(tmpFile.c_str(),
+                        std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!ofs) {
+      return false;
     }
-    for (std::string const& item : file.Uic.Depends) {
-      ofs << " udp:" << item << '\n';
+    ofs << content;
+    if (!ofs) {
+      ofs.close();
+      cmSystemTools::RemoveFile(tmpFile);
+      return false;
     }
   }
-  return ofs.Close();
+  if (!cmSystemTools::RenameFile(tmpFile, fileName)) {
+    cmSystemTools::RemoveFile(tmpFile);
+    return false;
+  }
+  return true;
 }
 
 cmQtAutoMocUicT::BaseSettingsT::BaseSettingsT() = default;
@@ -939,19 +1043,51 @@ void cmQtAutoMocUicT::JobMocPredefsT::Process()
       cm::append(cmd, this->MocConst().OptionsDefinitions);
       // Add includes
       cm::append(cmd, this->MocConst().OptionsIncludes);
-      // Check if response file is necessary
-      MaybeWriteResponseFile(this->MocConst().PredefsFileAbs, cmd);
-
-      MaybePrependCmdExe(cmd);
-
-      // Execute command
-      if (!this->RunProcess(GenT::MOC, result, cmd, reason.get())) {
-        this->LogCommandError(GenT::MOC,
-                              cmStrCat("The content generation command for ",
-                                       this->MessagePath(predefsFileAbs),
-                                       " failed.\n", result.ErrorMessage),
-                              cmd, result.StdOut);
-        return;
+
+      // Targets compiled with the same command share the result of
+      // running it through the build tree wide predefs cache.  The
+      // include directories in the command are always absolute.
+      std::string sharedFile;
+      if (!this->MocConst().PredefsSharedDir.empty()) {
+        cmCryptoHash cryptoHash(cmCryptoHash::AlgoSHA256);
+        cryptoHash.Initialize();
+        for (std::string const& arg : cmd) {
+          cryptoHash.Append(arg);
+          cryptoHash.Append(cm::string_view("\0", 1));
+        }
+        sharedFile = cmStrCat(this->MocConst().PredefsSharedDir, '/',
+                              cryptoHash.FinalizeHex(), ".h");
+      }
+
+      if (!sharedFile.empty() && this->ReadShared(sharedFile, result.StdOut)) {
+        if (reason && this->Log().Verbose()) {
+          this->Log().Info(GenT::MOC,
+                           cmStrCat(*reason, "\nReusing ",
+                                    this->MessagePath(sharedFile)));
+        }
+      } else {
+        // Check if response file is necessary
+        MaybeWriteResponseFile(this->MocConst().PredefsFileAbs, cmd);
+
+        MaybePrependCmdExe(cmd);
+
+        // Execute command
+        if (!this->RunProcess(GenT::MOC, result, cmd, reason.get())) {
+          this->LogCommandError(
+            GenT::MOC,
+            cmStrCat("The content generation command for ",
+                     this->MessagePath(predefsFileAbs), " failed.\n",
+                     result.ErrorMessage),
+            cmd, result.StdOut);
+          return;
+        }
+
+        // Publish the result for other targets.  The shared cache is
+        // only an optimization, so a failure is not an error.
+        if (!sharedFile.empty()) {
+          cmSystemTools::MakeDirectory(this->MocConst().PredefsSharedDir);
+          WriteSharedCacheFile(sharedFile, result.StdOut);
+        }
       }
     }
 
@@ -1028,6 +1164,22 @@ bool cmQtAutoMocUicT::JobMocPredefsT::Update(std::string* reason) const
   return false;
 }
 
+bool cmQtAutoMocUicT::JobMocPredefsT::ReadShared(
+  std::string const& sharedFile, std::string& content)
+{
+  // Ignore entries that are older than the compiler that produced them
+  cmFileTime sharedTime;
+  if (!sharedTime.Load(sharedFile)) {
+    return false;
+  }
+  cmFileTime execTime;
+  if (execTime.Load(this->MocConst().PredefsCmd.at(0)) &&
+      sharedTime.Older(execTime)) {
+    return false;
+  }
+  return cmQtAutoGenerator::FileRead(content, sharedFile);
+}
+
 bool cmQtAutoMocUicT::JobParseT::ReadFile()
 {
   // Clear old parse information
@@ -1057,6 +1209,53 @@ bool cmQtAutoMocUicT::JobParseT::ReadFile()
   return true;
 }
 
+bool cmQtAutoMocUicT::JobParseT::ReadSharedParseCache(char kind)
+{
+  std::string const& cacheDir = this->BaseConst().SharedParseCacheDir;
+  if (cacheDir.empty()) {
+    return false;
+  }
+
+  // Entries are keyed by the file and the parse settings and hold the
+  // hash of the content they were computed from.
+  SourceFileT& source = *this->FileHandle;
+  cmCryptoHash cryptoHash(cmCryptoHash::AlgoSHA256);
+  std::string const contentHash = cryptoHash.HashString(this->Content);
+  std::string const entryFile = cmStrCat(
+    cacheDir, '/',
+    cryptoHash.HashString(cmStrCat(this->BaseConst().SharedParseCacheSettings,
+                                   ';', kind, source.Moc ? 'm' : '-',
+                                   source.Uic ? 'u' : '-', ';',
+                                   source.FileName)),
+    ".txt");
+
+  if (ParseCacheT::ReadSharedEntry(entryFile, contentHash,
+                                   *source.ParseData)) {
+    if (this->Log().Verbose()) {
+      this->Log().Info(GenT::GEN,
+                       cmStrCat("Reusing shared parse result for ",
+                                this->MessagePath(source.FileName)));
+    }
+    return true;
+  }
+
+  // Remember where to publish the result of parsing this file.
+  source.SharedParseCacheFile = entryFile;
+  source.SharedParseCacheContent = contentHash;
+  return false;
+}
+
+void cmQtAutoMocUicT::JobParseT::StoreSharedParseCache()
+{
+  SourceFileT& source = *this->FileHandle;
+  if (source.SharedParseCacheFile.empty()) {
+    return;
+  }
+  // Serialize now, before later stages add target specific data.
+  source.SharedParseCacheContent = ParseCacheT::SharedEntryContent(
+    source.SharedParseCacheContent, *source.ParseData);
+}
+
 void cmQtAutoMocUicT::JobParseT::CreateKeys(
   std::vector<IncludeKeyT>& container, std::set<std::string> const& source,
   std::size_t basePrefixLength)
@@ -1188,6 +1387,9 @@ void cmQtAutoMocUicT::JobParseHeaderT::Process()
   if (!this->ReadFile()) {
     return;
   }
+  if (this->ReadSharedParseCache('h')) {
+    return;
+  }
   // Moc parsing
   if (this->FileHandle->Moc) {
     this->MocMacro();
@@ -1197,6 +1399,7 @@ void cmQtAutoMocUicT::JobParseHeaderT::Process()
   if (this->FileHandle->Uic) {
     this->UicIncludes();
   }
+  this->StoreSharedParseCache();
 }
 
 void cmQtAutoMocUicT::JobParseSourceT::Process()
@@ -1204,6 +1407,9 @@ void cmQtAutoMocUicT::JobParseSourceT::Process()
   if (!this->ReadFile()) {
     return;
   }
+  if (this->ReadSharedParseCache('s')) {
+    return;
+  }
   // Moc parsing
   if (this->FileHandle->Moc) {
     this->MocMacro();
@@ -1214,6 +1420,7 @@ void cmQtAutoMocUicT::JobParseSourceT::Process()
   if (this->FileHandle->Uic) {
     this->UicIncludes();
   }
+  this->StoreSharedParseCache();
 }
 
 std::string cmQtAutoMocUicT::JobEvalCacheT::MessageSearchLocations() const
@@ -1797,6 +2004,9 @@ void cmQtAutoMocUicT::JobEvalCacheFinishT::Process()
 
 void cmQtAutoMocUicT::JobProbeDepsMocT::Process()
 {
+  // This is the first job after the parse fence.
+  this->BaseEval().ParseEndTime = BaseEvalT::ClockT::now();
+
   // Create moc header jobs
   for (auto const& pair : this->MocEval().HeaderMappings) {
     // Register if this mapping is a candidate for mocs_compilation.cpp
@@ -1975,6 +2185,11 @@ cmQtAutoMocUicT::JobProbeDepsMocT::FindDependency(
 
 void cmQtAutoMocUicT::JobProbeDepsUicT::Process()
 {
+  // Without moc, this is the first job after the parse fence.
+  if (!this->MocConst().Enabled) {
+    this->BaseEval().ParseEndTime = BaseEvalT::ClockT::now();
+  }
+
   for (auto const& pair : this->Gen()->UicEval().Includes) {
     MappingHandleT const& mapping = pair.second;
     std::unique_ptr<std::string> reason;
@@ -2046,6 +2261,8 @@ bool cmQtAutoMocUicT::JobProbeDepsUicT::Probe(MappingT const& mapping,
 
 void cmQtAutoMocUicT::JobProbeDepsFinishT::Process()
 {
+  this->BaseEval().ProbeEndTime = BaseEvalT::ClockT::now();
+
   // Create output directories
   {
     using StringSet = std::unordered_set<std::string>;
@@ -2425,6 +2642,7 @@ void cmQtAutoMocUicT::JobDepFilesMergeT::Process()
 
 void cmQtAutoMocUicT::JobFinishT::Process()
 {
+  this->BaseEval().EndTime = BaseEvalT::ClockT::now();
   this->Gen()->AbortSuccess();
 }
 
@@ -2457,6 +2675,10 @@ bool cmQtAutoMocUicT::InitFromInfo(InfoT const& info)
                       true) ||
       !info.GetStringConfig("PARSE_CACHE_FILE",
                             this->BaseConst_.ParseCacheFile, true) ||
+      !info.GetStringConfig("TIMING_FILE", this->BaseConst_.TimingFile,
+                            false) ||
+      !info.GetString("PARSE_CACHE_SHARED_DIR",
+                      this->BaseConst_.SharedParseCacheDir, false) ||
       !info.GetStringConfig("SETTINGS_FILE", this->SettingsFile_, true) ||
       !info.GetArray("CMAKE_LIST_FILES", this->BaseConst_.ListFiles, true) ||
       !info.GetArray("HEADER_EXTENSIONS", this->BaseConst_.HeaderExtensions,
@@ -2515,6 +2737,10 @@ bool cmQtAutoMocUicT::InitFromInfo(InfoT const& info)
     std::min(this->BaseConst_.ThreadCount, ParallelMax);
   this->WorkerPool_.SetThreadCount(this->BaseConst_.ThreadCount);
 
+  // Settings that affect the results of parsing a file
+  this->BaseConst_.SharedParseCacheSettings =
+    cmStrCat(cmVersion::GetCMakeVersion(), ';');
+
   // -- Moc
   if (!this->MocConst_.Executable.empty()) {
     // -- Moc is enabled
@@ -2543,6 +2769,8 @@ bool cmQtAutoMocUicT::InitFromInfo(InfoT const& info)
         !info.GetStringConfig("MOC_PREDEFS_FILE",
                               this->MocConst_.PredefsFileAbs,
                               !this->MocConst_.PredefsCmd.empty()) ||
+        !info.GetString("MOC_PREDEFS_SHARED_DIR",
+                        this->MocConst_.PredefsSharedDir, false) ||
         !info.GetArray("MOC_MACRO_NAMES", tmp.MacroNames, true) ||
         !info.GetArray("MOC_DEPEND_FILTERS", tmp.DependFilters, false)) {
       return false;
@@ -2552,6 +2780,7 @@ bool cmQtAutoMocUicT::InitFromInfo(InfoT const& info)
     for (std::string const& item : tmp.MacroNames) {
       this->MocConst_.MacroFilters.emplace_back(
         item, ("[\n][ \t]*{?[ \t]*" + item).append("[^a-zA-Z0-9_]"));
+      this->BaseConst_.SharedParseCacheSettings += cmStrCat("mmc:", item, ';');
     }
     // Can moc output dependencies or do we need to setup dependency filters?
     if (this->BaseConst_.QtVersion >= IntegerVersion(5, 15)) {
@@ -2596,6 +2825,8 @@ bool cmQtAutoMocUicT::InitFromInfo(InfoT const& info)
         }
 
         this->MocConst_.DependFilters.emplace_back(key, exp);
+        this->BaseConst_.SharedParseCacheSettings +=
+          cmStrCat("mdp:", key, ';', exp, ';');
         if (testEntry(
               this->MocConst_.DependFilters.back().Exp.is_valid(),
               cmStrCat("Regular expression compilation failed.\nKeyword: ",
@@ -2931,12 +3162,14 @@ bool cmQtAutoMocUicT::Process()
     return false;
   }
   this->InitJobs();
+  this->BaseEval().StartTime = BaseEvalT::ClockT::now();
   if (!this->WorkerPool_.Process(this)) {
     return false;
   }
   if (this->JobError_) {
     return false;
   }
+  this->TimingWrite();
   if (!this->ParseCacheWrite()) {
     return false;
   }
@@ -3093,6 +3326,19 @@ void cmQtAutoMocUicT::ParseCacheRead()
 
 bool cmQtAutoMocUicT::ParseCacheWrite()
 {
+  // Publish freshly parsed files for other targets.  The shared cache is
+  // only an optimization, so failing to write an entry is not an error.
+  for (SourceFileMapT const* sourceMap :
+       { &this->BaseEval().Headers, &this->BaseEval().Sources }) {
+    for (auto const& pair : *sourceMap) {
+      SourceFileT const& source = *pair.second;
+      if (!source.SharedParseCacheFile.empty()) {
+        WriteSharedCacheFile(source.SharedParseCacheFile,
+                             source.SharedParseCacheContent);
+      }
+    }
+  }
+
   if (this->BaseEval().ParseCacheChanged) {
     if (this->Log().Verbose()) {
       this->Log().Info(
@@ -3113,6 +3359,46 @@ bool cmQtAutoMocUicT::ParseCacheWrite()
   return true;
 }
 
+void cmQtAutoMocUicT::TimingWrite()
+{
+  if (this->BaseConst().TimingFile.empty()) {
+    return;
+  }
+
+  // Report the wall clock time of each stage in seconds.  Stages whose
+  // end was not reached are reported as zero.
+  BaseEvalT const& eval = this->BaseEval();
+  auto seconds = [](BaseEvalT::ClockT::time_point begin,
+                    BaseEvalT::ClockT::time_point end) -> double {
+    if (end < begin) {
+      return 0.0;
+    }
+    return std::chrono::duration<double>(end - begin).count();
+  };
+  Json::Value timing = Json::objectValue;
+  timing["parse"] = seconds(eval.StartTime, eval.ParseEndTime);
+  timing["probe"] = seconds(eval.ParseEndTime, eval.ProbeEndTime);
+  timing["compile"] = seconds(eval.ProbeEndTime, eval.EndTime);
+  timing["total"] = seconds(eval.StartTime, eval.EndTime);
+
+  if (this->Log().Verbose()) {
+    this->Log().Info(
+      GenT::GEN,
+      cmStrCat("Timing: parse ", timing["parse"].asString(), "s, probe ",
+               timing["probe"].asString(), "s, compile ",
+               timing["compile"].asString(), "s"));
+  }
+
+  // The timing file is informational, so failing to write it is not
+  // an error.
+  cmGeneratedFileStream ofs(this->BaseConst().TimingFile);
+  if (ofs) {
+    Json::StyledStreamWriter writer("  ");
+    writer.write(ofs, timing);
+    ofs.Close();
+  }
+}
+
 bool cmQtAutoMocUicT::CreateDirectories()
 {
   // Create AUTOGEN include directory
@@ -3124,6 +3410,11 @@ bool cmQtAutoMocUicT::CreateDirectories()
                " failed."));
     return false;
   }
+  // Create the shared parse cache directory.  Entries are best effort,
+  // so a failure here only disables reuse between targets.
+  if (!this->BaseConst().SharedParseCacheDir.empty()) {
+    cmSystemTools::MakeDirectory(this->BaseConst().SharedParseCacheDir);
+  }
   return true;
 }
 
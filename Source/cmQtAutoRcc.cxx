@@ -3,7 +3,9 @@
 #include "cmQtAutoRcc.h"
 
 #include <algorithm>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <cmext/algorithm>
@@ -48,6 +50,10 @@ private:
   // -- Settings file
   bool SettingsFileRead();
   bool SettingsFileWrite();
+  // -- Manifest file
+  bool ManifestFileRead();
+  bool ManifestFileWrite(bool generated);
+  bool ListResources();
   // -- Tests
   bool TestQrcRccFiles(bool& generate);
   bool TestResources(bool& generate);
@@ -88,6 +94,19 @@ private:
   std::string SettingsString_;
   bool SettingsChanged_ = false;
   bool BuildFileChanged_ = false;
+  // -- Manifest file
+  struct ResourceT
+  {
+    cmFileTime::TimeType Time = 0;
+    std::string Hash;
+  };
+  std::string ManifestFile_;
+  std::string ManifestQrcHash_;
+  std::map<std::string, ResourceT> ManifestResources_;
+  std::string QrcFileHash_;
+  bool ManifestChanged_ = false;
+  // The rcc output is older than inputs whose content is unchanged
+  bool RccFileStale_ = false;
 };
 
 cmQtAutoRccT::cmQtAutoRccT()
@@ -108,6 +127,7 @@ bool cmQtAutoRccT::InitFromInfo(InfoT const& info)
       !info.GetArrayConfig("RCC_LIST_OPTIONS", this->RccListOptions_, false) ||
       !info.GetString("LOCK_FILE", this->LockFile_, true) ||
       !info.GetStringConfig("SETTINGS_FILE", this->SettingsFile_, true) ||
+      !info.GetStringConfig("MANIFEST_FILE", this->ManifestFile_, false) ||
       !info.GetString("SOURCE", this->QrcFile_, true) ||
       !info.GetString("OUTPUT_CHECKSUM", this->RccPathChecksum_, true) ||
       !info.GetString("OUTPUT_NAME", this->RccFileName_, true) ||
@@ -172,7 +192,7 @@ bool cmQtAutoRccT::InitFromInfo(InfoT const& info)
 
 bool cmQtAutoRccT::Process()
 {
-  if (!this->SettingsFileRead()) {
+  if (!this->SettingsFileRead() || !this->ManifestFileRead()) {
     return false;
   }
 
@@ -196,7 +216,7 @@ bool cmQtAutoRccT::Process()
     }
   }
 
-  if (!this->GenerateWrapper()) {
+  if (!this->GenerateWrapper() || !this->ManifestFileWrite(generate)) {
     return false;
   }
 
@@ -320,6 +340,134 @@ bool cmQtAutoRccT::SettingsFileWrite()
   return true;
 }
 
+bool cmQtAutoRccT::ManifestFileRead()
+{
+  if (this->ManifestFile_.empty()) {
+    return true;
+  }
+
+  // Hash the .qrc file content.  An unchanged hash allows ignoring a mere
+  // timestamp change of the .qrc file.
+  this->QrcFileHash_ =
+    cmCryptoHash(cmCryptoHash::AlgoSHA256).HashFile(this->QrcFile_);
+
+  // A manifest that was written with different settings is stale.
+  std::string content;
+  if (!FileRead(content, this->ManifestFile_) ||
+      SettingsFind(content, "rcc") != this->SettingsString_) {
+    return true;
+  }
+  this->ManifestQrcHash_ = SettingsFind(content, "qrc");
+
+  // Read resource entries of the form "res:<time>:<hash>:<path>"
+  cm::string_view remaining = content;
+  while (!remaining.empty()) {
+    cm::string_view line = remaining;
+    std::string::size_type const pos = remaining.find('\n');
+    if (pos != cm::string_view::npos) {
+      line = remaining.substr(0, pos);
+      remaining = remaining.substr(pos + 1);
+    } else {
+      remaining = cm::string_view();
+    }
+    if (!cmHasLiteralPrefix(line, "res:")) {
+      continue;
+    }
+    line = line.substr(4);
+    std::string::size_type const timeEnd = line.find(':');
+    if (timeEnd == cm::string_view::npos) {
+      continue;
+    }
+    std::string::size_type const hashEnd = line.find(':', timeEnd + 1);
+    if (hashEnd == cm::string_view::npos) {
+      continue;
+    }
+    ResourceT res;
+    if (!cmStrToLongLong(std::string(line.substr(0, timeEnd)), &res.Time)) {
+      continue;
+    }
+    res.Hash = std::string(line.substr(timeEnd + 1, hashEnd - timeEnd - 1));
+    this->ManifestResources_.emplace(std::string(line.substr(hashEnd + 1)),
+                                     std::move(res));
+  }
+  return true;
+}
+
+bool cmQtAutoRccT::ManifestFileWrite(bool generated)
+{
+  if (this->ManifestFile_.empty() ||
+      (!generated && !this->ManifestChanged_)) {
+    return true;
+  }
+
+  if (generated) {
+    // Record the resources the rcc output was generated from
+    if (!this->ListResources()) {
+      return false;
+    }
+    std::map<std::string, ResourceT> resources;
+    for (std::string const& resFile : this->Inputs_) {
+      ResourceT res;
+      cmFileTime fileTime;
+      if (fileTime.Load(resFile)) {
+        res.Time = fileTime.GetTime();
+      }
+      auto it = this->ManifestResources_.find(resFile);
+      if (it != this->ManifestResources_.end() &&
+          it->second.Time == res.Time) {
+        res.Hash = std::move(it->second.Hash);
+      } else {
+        res.Hash = cmCryptoHash(cmCryptoHash::AlgoSHA256).HashFile(resFile);
+      }
+      resources.emplace(resFile, std::move(res));
+    }
+    this->ManifestResources_ = std::move(resources);
+    this->ManifestQrcHash_ = this->QrcFileHash_;
+  }
+
+  if (this->Log().Verbose()) {
+    this->Log().Info(GenT::RCC,
+                     "Writing manifest file " +
+                       this->MessagePath(this->ManifestFile_));
+  }
+  std::string content = cmStrCat("rcc:", this->SettingsString_, '\n', "qrc:",
+                                 this->ManifestQrcHash_, '\n');
+  for (auto const& pair : this->ManifestResources_) {
+    content += cmStrCat("res:", pair.second.Time, ':', pair.second.Hash, ':',
+                        pair.first, '\n');
+  }
+  std::string error;
+  if (!FileWrite(this->ManifestFile_, content, &error)) {
+    this->Log().Error(GenT::RCC,
+                      cmStrCat("Writing of the manifest file ",
+                               this->MessagePath(this->ManifestFile_),
+                               " failed.\n", error));
+    cmSystemTools::RemoveFile(this->ManifestFile_);
+    return false;
+  }
+  return true;
+}
+
+bool cmQtAutoRccT::ListResources()
+{
+  if (!this->Inputs_.empty()) {
+    return true;
+  }
+
+  // Always ask rcc, since directory entries of an unchanged .qrc file may
+  // list different files.
+  std::string error;
+  RccLister const lister(this->RccExecutable_, this->RccListOptions_);
+  if (!lister.list(this->QrcFile_, this->Inputs_, error,
+                   this->Log().Verbose())) {
+    this->Log().Error(GenT::RCC,
+                      cmStrCat("Listing of ", this->MessagePath(this->QrcFile_),
+                               " failed.\n", error));
+    return false;
+  }
+  return true;
+}
+
 /// Do basic checks if rcc generation is required
 bool cmQtAutoRccT::TestQrcRccFiles(bool& generate)
 {
@@ -356,8 +504,11 @@ bool cmQtAutoRccT::TestQrcRccFiles(bool& generate)
     return true;
   }
 
-  // Test if the rcc output file is older than the .qrc file
-  if (this->RccFileTime_.Older(this->QrcFileTime_)) {
+  // Test if the rcc output file is older than the .qrc file.
+  // A newer .qrc file with unchanged content does not require regeneration.
+  if (this->RccFileTime_.Older(this->QrcFileTime_) &&
+      (this->QrcFileHash_.empty() ||
+       this->QrcFileHash_ != this->ManifestQrcHash_)) {
     if (this->Log().Verbose()) {
       this->Reason = cmStrCat(
         "Generating ", this->MessagePath(this->RccFileOutput_),
@@ -367,6 +518,9 @@ bool cmQtAutoRccT::TestQrcRccFiles(bool& generate)
     generate = true;
     return true;
   }
+  if (this->RccFileTime_.Older(this->QrcFileTime_)) {
+    this->RccFileStale_ = true;
+  }
 
   // Test if the rcc output file is older than the rcc executable
   if (this->RccFileTime_.Older(this->RccExecutableTime_)) {
@@ -386,16 +540,25 @@ bool cmQtAutoRccT::TestQrcRccFiles(bool& generate)
 bool cmQtAutoRccT::TestResources(bool& generate)
 {
   // Read resource files list
-  if (this->Inputs_.empty()) {
-    std::string error;
-    RccLister const lister(this->RccExecutable_, this->RccListOptions_);
-    if (!lister.list(this->QrcFile_, this->Inputs_, error,
-                     this->Log().Verbose())) {
-      this->Log().Error(GenT::RCC,
-                        cmStrCat("Listing of ",
-                                 this->MessagePath(this->QrcFile_),
-                                 " failed.\n", error));
-      return false;
+  if (!this->ListResources()) {
+    return false;
+  }
+
+  // Test if the list differs from the one the rcc output was generated from
+  if (!this->ManifestQrcHash_.empty()) {
+    if (this->Inputs_.size() != this->ManifestResources_.size() ||
+        std::any_of(this->Inputs_.begin(), this->Inputs_.end(),
+                    [this](std::string const& resFile) {
+                      return this->ManifestResources_.count(resFile) == 0;
+                    })) {
+      if (this->Log().Verbose()) {
+        this->Reason =
+          cmStrCat("Generating ", this->MessagePath(this->RccFileOutput_),
+                   ", because the list of resources changed, from ",
+                   this->MessagePath(this->QrcFile_));
+      }
+      generate = true;
+      return true;
     }
   }
 
@@ -413,6 +576,24 @@ bool cmQtAutoRccT::TestResources(bool& generate)
     }
     // Check if the resource file is newer than the rcc output file
     if (this->RccFileTime_.Older(fileTime)) {
+      // Ignore the newer timestamp if the content is still the one the
+      // rcc output was generated from
+      auto it = this->ManifestResources_.find(resFile);
+      if (it != this->ManifestResources_.end()) {
+        ResourceT& res = it->second;
+        if (res.Time == fileTime.GetTime()) {
+          this->RccFileStale_ = true;
+          continue;
+        }
+        if (!res.Hash.empty() &&
+            res.Hash ==
+              cmCryptoHash(cmCryptoHash::AlgoSHA256).HashFile(resFile)) {
+          res.Time = fileTime.GetTime();
+          this->ManifestChanged_ = true;
+          this->RccFileStale_ = true;
+          continue;
+        }
+      }
       if (this->Log().Verbose()) {
         this->Reason =
           cmStrCat("Generating ", this->MessagePath(this->RccFileOutput_),
@@ -437,17 +618,31 @@ bool cmQtAutoRccT::TestInfoFile()
                                 " because it is older than ",
                                 this->MessagePath(this->InfoFile())));
     }
-    // Touch build file
-    if (!cmSystemTools::Touch(this->RccFileOutput_, false)) {
-      this->Log().Error(GenT::RCC,
-                        cmStrCat("Touching ",
-                                 this->MessagePath(this->RccFileOutput_),
-                                 " failed."));
-      return false;
+  } else if (this->RccFileStale_ &&
+             this->GetGenerator().find("Ninja") == std::string::npos) {
+    // Without restat support the build system would rerun the rcc rule
+    // on every build while the output is older than its dependencies.
+    if (this->Log().Verbose()) {
+      this->Log().Info(GenT::RCC,
+                       cmStrCat("Touching ",
+                                this->MessagePath(this->RccFileOutput_),
+                                " because it is older than resources with "
+                                "unchanged content from ",
+                                this->MessagePath(this->QrcFile_)));
     }
-    this->BuildFileChanged_ = true;
+  } else {
+    return true;
   }
 
+  // Touch build file
+  if (!cmSystemTools::Touch(this->RccFileOutput_, false)) {
+    this->Log().Error(GenT::RCC,
+                      cmStrCat("Touching ",
+                               this->MessagePath(this->RccFileOutput_),
+                               " failed."));
+    return false;
+  }
+  this->BuildFileChanged_ = true;
   return true;
 }
 
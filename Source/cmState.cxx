@@ -222,9 +222,9 @@ bool cmState::DoWriteGlobVerifyTarget() const
   return this->GlobVerificationManager->DoWriteVerifyTarget();
 }
 
-std::string const& cmState::GetGlobVerifyScript() const
+std::string const& cmState::GetGlobVerifyData() const
 {
-  return this->GlobVerificationManager->GetVerifyScript();
+  return this->GlobVerificationManager->GetVerifyData();
 }
 
 std::string const& cmState::GetGlobVerifyStamp() const
@@ -232,11 +232,9 @@ std::string const& cmState::GetGlobVerifyStamp() const
   return this->GlobVerificationManager->GetVerifyStamp();
 }
 
-bool cmState::SaveVerificationScript(const std::string& path,
-                                     cmMessenger* messenger)
+bool cmState::SaveVerificationData(const std::string& path)
 {
-  return this->GlobVerificationManager->SaveVerificationScript(path,
-                                                               messenger);
+  return this->GlobVerificationManager->SaveVerificationData(path);
 }
 
 void cmState::AddGlobCacheEntry(const cmGlobCacheEntry& entry,
@@ -263,9 +263,9 @@ private:
                      cmStateEnums::CacheEntryType type);
 
   bool DoWriteGlobVerifyTarget() const;
-  std::string const& GetGlobVerifyScript() const;
+  std::string const& GetGlobVerifyData() const;
   std::string const& GetGlobVerifyStamp() const;
-  bool SaveVerificationScript(const std::string& path, cmMessenger* messenger);
+  bool SaveVerificationData(const std::string& path);
   void AddGlobCacheEntry(const cmGlobCacheEntry& entry,
                          const std::string& variable,
                          cmListFileBacktrace const& bt,
@@ -39,6 +39,15 @@
 #include "cmWorkingDirectory.h"
 
 #if !defined(CMAKE_BOOTSTRAP)
+#  include <condition_variable>
+#  include <deque>
+#  include <limits>
+#  include <mutex>
+#  include <thread>
+#  include <unordered_set>
+
+#  include <cm/algorithm>
+
 #  include <cm3p/archive.h>
 #  include <cm3p/archive_entry.h>
 
@@ -1871,7 +1880,8 @@ bool cmSystemTools::CreateTar(const std::string& outFileName,
                               const std::string& workingDirectory,
                               cmTarCompression compressType, bool verbose,
                               std::string const& mtime,
-                              std::string const& format, int compressionLevel)
+                              std::string const& format, int compressionLevel,
+                              int numThreads)
 {
 #if !defined(CMAKE_BOOTSTRAP)
   cmWorkingDirectory workdir(cmSystemTools::GetCurrentWorkingDirectory());
@@ -1907,7 +1917,7 @@ bool cmSystemTools::CreateTar(const std::string& outFileName,
   }
 
   cmArchiveWrite a(fout, compress, format.empty() ? "paxr" : format,
-                   compressionLevel);
+                   compressionLevel, numThreads);
 
   if (!a.Open()) {
     cmSystemTools::Error(a.GetError());
@@ -2108,10 +2118,231 @@ bool copy_data(struct archive* ar, struct archive* aw)
 #  endif
 }
 
+/** Write regular file entries to disk on a pool of worker threads.
+
+    The reading thread buffers the data of each regular file entry and
+    hands it off, so that decompression overlaps with file creation and
+    several files are written concurrently.  Each worker owns its own
+    disk writer.  Directories, links, and large files are still written
+    by the reading thread; it calls Wait() when an entry may depend on
+    a file that is still in flight.  */
+class ParallelDiskWriter
+{
+public:
+  /** Files larger than this are written by the reading thread.  */
+  static size_t const MaxFileSize = 16 * 1024 * 1024;
+
+  struct Block
+  {
+    __LA_INT64_T Offset;
+    std::string Data;
+  };
+
+  ParallelDiskWriter(int options, unsigned int numThreads);
+  ~ParallelDiskWriter();
+
+  ParallelDiskWriter(ParallelDiskWriter const&) = delete;
+  ParallelDiskWriter& operator=(ParallelDiskWriter const&) = delete;
+
+  /** Queue a cloned entry and its data.  Takes ownership of the entry.
+      Returns false if a previously queued entry has failed.  */
+  bool Submit(struct archive_entry* entry, std::vector<Block> blocks,
+              size_t size);
+
+  /** Block until all queued entries have been written.  */
+  bool Wait();
+
+  bool IsPending(std::string const& path);
+  std::string const& GetError() const { return this->Error; }
+
+private:
+  struct Job
+  {
+    struct archive_entry* Entry;
+    std::string Path;
+    std::vector<Block> Blocks;
+    size_t Size;
+  };
+
+  void Work();
+  bool WriteJob(struct archive* ext, Job const& job, std::string& error);
+
+  int Options;
+  size_t MaxInFlight;
+  size_t InFlight = 0;
+  size_t Active = 0;
+  bool Stop = false;
+  std::string Error;
+  std::mutex Mutex;
+  std::condition_variable WorkAvailable;
+  std::condition_variable WorkDone;
+  std::deque<Job> Queue;
+  std::unordered_set<std::string> PendingPaths;
+  std::vector<std::thread> Threads;
+};
+
+ParallelDiskWriter::ParallelDiskWriter(int options, unsigned int numThreads)
+  : Options(options)
+  , MaxInFlight(4 * MaxFileSize)
+{
+  this->Threads.reserve(numThreads);
+  for (unsigned int i = 0; i < numThreads; ++i) {
+    this->Threads.emplace_back(&ParallelDiskWriter::Work, this);
+  }
+}
+
+ParallelDiskWriter::~ParallelDiskWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Stop = true;
+  }
+  this->WorkAvailable.notify_all();
+  for (std::thread& t : this->Threads) {
+    t.join();
+  }
+  for (Job& job : this->Queue) {
+    archive_entry_free(job.Entry);
+  }
+}
+
+bool ParallelDiskWriter::Submit(struct archive_entry* entry,
+                                std::vector<Block> blocks, size_t size)
+{
+  Job job{ entry, cm_archive_entry_pathname(entry), std::move(blocks),
+           size };
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->WorkDone.wait(lock, [this, size]() {
+      return !this->Error.empty() || this->InFlight == 0 ||
+        this->InFlight + size <= this->MaxInFlight;
+    });
+    if (!this->Error.empty()) {
+      archive_entry_free(job.Entry);
+      return false;
+    }
+    this->InFlight += size;
+    this->PendingPaths.insert(job.Path);
+    this->Queue.emplace_back(std::move(job));
+  }
+  this->WorkAvailable.notify_one();
+  return true;
+}
+
+bool ParallelDiskWriter::Wait()
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  this->WorkDone.wait(lock, [this]() {
+    return this->Queue.empty() && this->Active == 0;
+  });
+  return this->Error.empty();
+}
+
+bool ParallelDiskWriter::IsPending(std::string const& path)
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  return this->PendingPaths.count(path) != 0;
+}
+
+void ParallelDiskWriter::Work()
+{
+  struct archive* ext = archive_write_disk_new();
+  archive_write_disk_set_options(ext, this->Options);
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  for (;;) {
+    this->WorkAvailable.wait(
+      lock, [this]() { return this->Stop || !this->Queue.empty(); });
+    if (this->Queue.empty()) {
+      break;
+    }
+    Job job = std::move(this->Queue.front());
+    this->Queue.pop_front();
+    ++this->Active;
+    bool const failed = !this->Error.empty();
+    lock.unlock();
+
+    // Once an entry has failed, drop the rest.
+    std::string error;
+    bool const ok = !failed && this->WriteJob(ext, job, error);
+    archive_entry_free(job.Entry);
+    job.Blocks.clear();
+
+    lock.lock();
+    if (!ok && this->Error.empty()) {
+      this->Error = std::move(error);
+    }
+    this->InFlight -= job.Size;
+    this->PendingPaths.erase(job.Path);
+    --this->Active;
+    this->WorkDone.notify_all();
+  }
+  lock.unlock();
+  archive_write_free(ext);
+}
+
+bool ParallelDiskWriter::WriteJob(struct archive* ext, Job const& job,
+                                  std::string& error)
+{
+  char const* step = "archive_write_header";
+  if (archive_write_header(ext, job.Entry) == ARCHIVE_OK) {
+    step = "archive_write_data_block";
+    bool ok = true;
+    for (Block const& block : job.Blocks) {
+      if (archive_write_data_block(ext, block.Data.data(), block.Data.size(),
+                                   block.Offset) < ARCHIVE_WARN) {
+        ok = false;
+        break;
+      }
+    }
+    if (ok) {
+      step = "archive_write_finish_entry";
+      if (archive_write_finish_entry(ext) == ARCHIVE_OK) {
+        return true;
+      }
+    }
+  }
+  char const* m = archive_error_string(ext);
+  error = cmStrCat("Problem with ", step, "(): ", m ? m : "unknown error",
+                   "\nCurrent file: ", job.Path);
+  return false;
+}
+
+// Read the data of the current entry into memory.
+bool read_data(struct archive* ar, std::vector<ParallelDiskWriter::Block>& out)
+{
+  const void* buff;
+  size_t size;
+#  if defined(ARCHIVE_VERSION_NUMBER) && ARCHIVE_VERSION_NUMBER >= 3000000
+  __LA_INT64_T offset;
+#  else
+  off_t offset;
+#  endif
+
+  for (;;) {
+    // See archive.h definition of ARCHIVE_OK for return values.
+    long const r = archive_read_data_block(ar, &buff, &size, &offset);
+    if (r == ARCHIVE_EOF) {
+      return true;
+    }
+    if (!la_diagnostic(ar, r)) {
+      return false;
+    }
+    if (!out.empty() &&
+        out.back().Offset +
+            static_cast<__LA_INT64_T>(out.back().Data.size()) ==
+          offset) {
+      out.back().Data.append(static_cast<const char*>(buff), size);
+    } else {
+      out.push_back({ offset, std::string(static_cast<const char*>(buff),
+                                          size) });
+    }
+  }
+}
+
 bool extract_tar(const std::string& outFileName,
                  const std::vector<std::string>& files, bool verbose,
                  cmSystemTools::cmTarExtractTimestamps extractTimestamps,
-                 bool extract)
+                 bool extract, int numThreads = 1)
 {
   cmLocaleRAII localeRAII;
   static_cast<void>(localeRAII);
@@ -2135,13 +2366,33 @@ bool extract_tar(const std::string& outFileName,
     }
   }
 
-  int r = cm_archive_read_open_file(a, outFileName.c_str(), 10240);
+  // Read in large blocks to reduce the number of system calls.
+  int r = cm_archive_read_open_file(a, outFileName.c_str(), 1024 * 1024);
   if (r) {
     ArchiveError("Problem with archive_read_open_file(): ", a);
     archive_write_free(ext);
     archive_read_close(a);
     return false;
   }
+
+  std::unique_ptr<ParallelDiskWriter> writer;
+  if (extract && numThreads != 1) {
+    if (numThreads < 1) {
+      int upperLimit = (numThreads == 0) ? std::numeric_limits<int>::max()
+                                         : std::abs(numThreads);
+      numThreads =
+        cm::clamp<int>(std::thread::hardware_concurrency(), 1, upperLimit);
+    }
+    if (numThreads > 1) {
+      int const options =
+        extractTimestamps == cmSystemTools::cmTarExtractTimestamps::Yes
+        ? ARCHIVE_EXTRACT_TIME
+        : 0;
+      writer = cm::make_unique<ParallelDiskWriter>(
+        options, static_cast<unsigned int>(numThreads));
+    }
+  }
+
   for (;;) {
     r = archive_read_next_header(a, &entry);
     if (r == ARCHIVE_EOF) {
@@ -2176,6 +2427,38 @@ bool extract_tar(const std::string& outFileName,
         }
       }
 
+      if (writer) {
+        if (archive_entry_filetype(entry) == AE_IFREG &&
+            !archive_entry_hardlink(entry) &&
+            archive_entry_size(entry) <=
+              static_cast<__LA_INT64_T>(ParallelDiskWriter::MaxFileSize) &&
+            !writer->IsPending(cm_archive_entry_pathname(entry))) {
+          std::vector<ParallelDiskWriter::Block> blocks;
+          if (!read_data(a, blocks)) {
+            r = ARCHIVE_FATAL;
+            break;
+          }
+          size_t size = 0;
+          for (ParallelDiskWriter::Block const& block : blocks) {
+            size += block.Data.size();
+          }
+          if (!writer->Submit(archive_entry_clone(entry), std::move(blocks),
+                              size)) {
+            r = ARCHIVE_FATAL;
+            break;
+          }
+          continue;
+        }
+        // Directories may be created concurrently, but anything else may
+        // refer to or replace a file that is still in flight.
+        if ((archive_entry_filetype(entry) != AE_IFDIR ||
+             writer->IsPending(cm_archive_entry_pathname(entry))) &&
+            !writer->Wait()) {
+          r = ARCHIVE_FATAL;
+          break;
+        }
+      }
+
       r = archive_write_header(ext, entry);
       if (r == ARCHIVE_OK) {
         if (!copy_data(a, ext)) {
@@ -2203,6 +2486,16 @@ bool extract_tar(const std::string& outFileName,
     }
   }
 
+  if (writer) {
+    if (!writer->Wait()) {
+      r = ARCHIVE_FATAL;
+    }
+    if (!writer->GetError().empty()) {
+      cmSystemTools::Error(writer->GetError());
+    }
+    writer.reset();
+  }
+
   bool error_occured = false;
   if (matching) {
     const char* p;
@@ -2234,10 +2527,11 @@ bool extract_tar(const std::string& outFileName,
 bool cmSystemTools::ExtractTar(const std::string& outFileName,
                                const std::vector<std::string>& files,
                                cmTarExtractTimestamps extractTimestamps,
-                               bool verbose)
+                               bool verbose, int numThreads)
 {
 #if !defined(CMAKE_BOOTSTRAP)
-  return extract_tar(outFileName, files, verbose, extractTimestamps, true);
+  return extract_tar(outFileName, files, verbose, extractTimestamps, true,
+                     numThreads);
 #else
   (void)outFileName;
   (void)files;
@@ -501,11 +501,11 @@ public:
                         cmTarCompression compressType, bool verbose,
                         std::string const& mtime = std::string(),
                         std::string const& format = std::string(),
-                        int compressionLevel = 0);
+                        int compressionLevel = 0, int numThreads = 1);
   static bool ExtractTar(const std::string& inFileName,
                          const std::vector<std::string>& files,
                          cmTarExtractTimestamps extractTimestamps,
-                         bool verbose);
+                         bool verbose, int numThreads = 1);
 
   static void EnsureStdPipes();
 
@@ -47,6 +47,7 @@
 #include "cmDocumentation.h"
 #include "cmDocumentationEntry.h"
 #include "cmDuration.h"
+#include "cmExecuteProcessCommand.h"
 #include "cmExternalMakefileProjectGenerator.h"
 #include "cmFileTimeCache.h"
 #include "cmGeneratorTarget.h"
@@ -354,6 +355,14 @@ cmake::cmake(Role role, cmState::Mode mode, cmState::ProjectKind projectKind)
 
 cmake::~cmake() = default;
 
+cmExecuteProcessJobs& cmake::GetExecuteProcessJobs()
+{
+  if (!this->ExecuteProcessJobs) {
+    this->ExecuteProcessJobs = cm::make_unique<cmExecuteProcessJobs>();
+  }
+  return *this->ExecuteProcessJobs;
+}
+
 #if !defined(CMAKE_BOOTSTRAP)
 Json::Value cmake::ReportVersionJson() const
 {
@@ -2565,6 +2574,9 @@ int cmake::ActualConfigure()
   this->GlobalGenerator->Configure();
   auto endTime = std::chrono::steady_clock::now();
 
+  // Drop execute_process(ASYNC) results that were never waited for.
+  this->ExecuteProcessJobs.reset();
+
   if (this->GetWorkingMode() == cmake::NORMAL_MODE) {
     std::ostringstream msg;
     if (cmSystemTools::GetErrorOccurredFlag()) {
@@ -2617,8 +2629,7 @@ int cmake::ActualConfigure()
       "CMakeLists.txt ?");
   }
 
-  this->State->SaveVerificationScript(this->GetHomeOutputDirectory(),
-                                      this->Messenger.get());
+  this->State->SaveVerificationData(this->GetHomeOutputDirectory());
   this->SaveCache(this->GetHomeOutputDirectory());
   if (cmSystemTools::GetErrorOccurredFlag()) {
     return -1;
@@ -2967,9 +2978,9 @@ bool cmake::DoWriteGlobVerifyTarget() const
   return this->State->DoWriteGlobVerifyTarget();
 }
 
-std::string const& cmake::GetGlobVerifyScript() const
+std::string const& cmake::GetGlobVerifyData() const
 {
-  return this->State->GetGlobVerifyScript();
+  return this->State->GetGlobVerifyData();
 }
 
 std::string const& cmake::GetGlobVerifyStamp() const
@@ -3239,6 +3250,45 @@ void cmake::UpdateConversionPathTable()
   }
 }
 
+namespace {
+/**
+ * Read the products, dependencies, and outputs of the generate step from
+ * the plain check file written next to the rerun check file.  Returns
+ * false if the file does not exist or cannot be parsed.
+ */
+bool ReadCheckBuildSystemFile(std::string const& fileName, cmList& products,
+                              cmList& depends, cmList& outputs)
+{
+  cmsys::ifstream fin(fileName.c_str());
+  if (!fin) {
+    return false;
+  }
+  std::string line;
+  while (cmSystemTools::GetLineFromStream(fin, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    if (line.size() < 3 || line[1] != ' ') {
+      return false;
+    }
+    switch (line[0]) {
+      case 'P':
+        products.emplace_back(line.substr(2));
+        break;
+      case 'D':
+        depends.emplace_back(line.substr(2));
+        break;
+      case 'O':
+        outputs.emplace_back(line.substr(2));
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+}
+
 int cmake::CheckBuildSystem()
 {
   // We do not need to rerun CMake.  Check dependency integrity.
@@ -3267,47 +3317,75 @@ int cmake::CheckBuildSystem()
     return 1;
   }
 
-  // Read the rerun check file and use it to decide whether to do the
-  // global generate.
-  // Actually, all we need is the `set` command.
-  cmake cm(RoleScript, cmState::Unknown);
-  cm.SetHomeDirectory("");
-  cm.SetHomeOutputDirectory("");
-  cm.GetCurrentSnapshot().SetDefaultDefinitions();
-  cmGlobalGenerator gg(&cm);
-  cmMakefile mf(&gg, cm.GetCurrentSnapshot());
-  if (!mf.ReadListFile(this->CheckBuildSystemArgument) ||
-      cmSystemTools::GetErrorOccurredFlag()) {
-    if (verbose) {
-      std::ostringstream msg;
-      msg << "Re-run cmake error reading : " << this->CheckBuildSystemArgument
-          << '\n';
-      cmSystemTools::Stdout(msg.str());
+  cmList products;
+  cmList depends;
+  cmList outputs;
+
+  // The generator may write the information needed below in a plain
+  // format next to the rerun check file.  Reading that avoids evaluating
+  // the rerun check file as a CMake script.  It is only valid if it is
+  // not older than the rerun check file.
+  std::string const checkFile =
+    cmStrCat(this->CheckBuildSystemArgument, ".check");
+  int checkFileAge = 0;
+  bool const haveCheckFile = !this->ClearBuildSystem &&
+    this->FileTimeCache->Compare(checkFile, this->CheckBuildSystemArgument,
+                                 &checkFileAge) &&
+    checkFileAge >= 0 &&
+    ReadCheckBuildSystemFile(checkFile, products, depends, outputs);
+
+  if (!haveCheckFile) {
+    products.clear();
+    depends.clear();
+    outputs.clear();
+
+    // Read the rerun check file and use it to decide whether to do the
+    // global generate.
+    // Actually, all we need is the `set` command.
+    cmake cm(RoleScript, cmState::Unknown);
+    cm.SetHomeDirectory("");
+    cm.SetHomeOutputDirectory("");
+    cm.GetCurrentSnapshot().SetDefaultDefinitions();
+    cmGlobalGenerator gg(&cm);
+    cmMakefile mf(&gg, cm.GetCurrentSnapshot());
+    if (!mf.ReadListFile(this->CheckBuildSystemArgument) ||
+        cmSystemTools::GetErrorOccurredFlag()) {
+      if (verbose) {
+        std::ostringstream msg;
+        msg << "Re-run cmake error reading : "
+            << this->CheckBuildSystemArgument << '\n';
+        cmSystemTools::Stdout(msg.str());
+      }
+      // There was an error reading the file.  Just rerun.
+      return 1;
     }
-    // There was an error reading the file.  Just rerun.
-    return 1;
-  }
 
-  if (this->ClearBuildSystem) {
-    // Get the generator used for this build system.
-    std::string genName = mf.GetSafeDefinition("CMAKE_DEPENDS_GENERATOR");
-    if (!cmNonempty(genName)) {
-      genName = "Unix Makefiles";
+    if (this->ClearBuildSystem) {
+      // Get the generator used for this build system.
+      std::string genName = mf.GetSafeDefinition("CMAKE_DEPENDS_GENERATOR");
+      if (!cmNonempty(genName)) {
+        genName = "Unix Makefiles";
+      }
+
+      // Create the generator and use it to clear the dependencies.
+      std::unique_ptr<cmGlobalGenerator> ggd =
+        this->CreateGlobalGenerator(genName);
+      if (ggd) {
+        cm.GetCurrentSnapshot().SetDefaultDefinitions();
+        cmMakefile mfd(ggd.get(), cm.GetCurrentSnapshot());
+        auto lgd = ggd->CreateLocalGenerator(&mfd);
+        lgd->ClearDependencies(&mfd, verbose);
+      }
     }
 
-    // Create the generator and use it to clear the dependencies.
-    std::unique_ptr<cmGlobalGenerator> ggd =
-      this->CreateGlobalGenerator(genName);
-    if (ggd) {
-      cm.GetCurrentSnapshot().SetDefaultDefinitions();
-      cmMakefile mfd(ggd.get(), cm.GetCurrentSnapshot());
-      auto lgd = ggd->CreateLocalGenerator(&mfd);
-      lgd->ClearDependencies(&mfd, verbose);
+    products.assign(mf.GetDefinition("CMAKE_MAKEFILE_PRODUCTS"));
+    depends.assign(mf.GetDefinition("CMAKE_MAKEFILE_DEPENDS"));
+    if (!depends.empty()) {
+      outputs.assign(mf.GetDefinition("CMAKE_MAKEFILE_OUTPUTS"));
     }
   }
 
   // If any byproduct of makefile generation is missing we must re-run.
-  cmList products{ mf.GetDefinition("CMAKE_MAKEFILE_PRODUCTS") };
   for (auto const& p : products) {
     if (!cmSystemTools::PathExists(p)) {
       if (verbose) {
@@ -3318,12 +3396,7 @@ int cmake::CheckBuildSystem()
     }
   }
 
-  // Get the set of dependencies and outputs.
-  cmList depends{ mf.GetDefinition("CMAKE_MAKEFILE_DEPENDS") };
-  cmList outputs;
-  if (!depends.empty()) {
-    outputs.assign(mf.GetDefinition("CMAKE_MAKEFILE_OUTPUTS"));
-  }
+  // Check the set of dependencies and outputs.
   if (depends.empty() || outputs.empty()) {
     // Not enough information was provided to do the test.  Just rerun.
     if (verbose) {
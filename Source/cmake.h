@@ -47,6 +47,7 @@ class cmDebuggerAdapter;
 #endif
 
 class cmExternalMakefileProjectGeneratorFactory;
+class cmExecuteProcessJobs;
 class cmFileAPI;
 class cmFileTimeCache;
 class cmGlobalGenerator;
@@ -359,7 +360,7 @@ public:
                      int type);
 
   bool DoWriteGlobVerifyTarget() const;
-  std::string const& GetGlobVerifyScript() const;
+  std::string const& GetGlobVerifyData() const;
   std::string const& GetGlobVerifyStamp() const;
   void AddGlobCacheEntry(const cmGlobCacheEntry& entry,
                          const std::string& variable,
@@ -462,6 +463,9 @@ public:
    */
   cmFileTimeCache* GetFileTimeCache() { return this->FileTimeCache.get(); }
 
+  //! Get the process chains started by execute_process.
+  cmExecuteProcessJobs& GetExecuteProcessJobs();
+
   bool WasLogLevelSetViaCLI() const { return this->LogLevelWasSetViaCLI; }
 
   //! Get the selected log level for `message()` commands during the cmake run.
@@ -780,6 +784,7 @@ private:
   bool FreshCache = false;
   bool RegenerateDuringBuild = false;
   std::unique_ptr<cmFileTimeCache> FileTimeCache;
+  std::unique_ptr<cmExecuteProcessJobs> ExecuteProcessJobs;
   std::string GraphVizFile;
   InstalledFilesMap InstalledFiles;
 #ifndef CMAKE_BOOTSTRAP
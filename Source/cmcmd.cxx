@@ -15,6 +15,7 @@
 #include "cmConsoleBuf.h"
 #include "cmCryptoHash.h"
 #include "cmDuration.h"
+#include "cmGlobVerificationManager.h"
 #include "cmGlobalGenerator.h"
 #include "cmList.h"
 #include "cmLocalGenerator.h"
@@ -1385,6 +1386,11 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args,
       return cmcmd::ExecuteLinkScript(args);
     }
 
+    // Internal CMake glob verification support.
+    if (args[1] == "cmake_verify_globs" && args.size() == 3) {
+      return cmGlobVerificationManager::VerifyGlobs(args[2]) ? 0 : 1;
+    }
+
 #if !defined(CMAKE_BOOTSTRAP)
     // Internal CMake ninja dependency scanning support.
     if (args[1] == "cmake_ninja_depends") {
@@ -1456,6 +1462,7 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args,
       std::vector<std::string> files;
       std::string mtime;
       std::string format;
+      long threads = 1;
       cmSystemTools::cmTarExtractTimestamps extractTimestamps =
         cmSystemTools::cmTarExtractTimestamps::Yes;
       cmSystemTools::cmTarCompression compress =
@@ -1483,6 +1490,12 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args,
                                    format);
               return 1;
             }
+          } else if (cmHasLiteralPrefix(arg, "--threads=")) {
+            if (!cmStrToLong(arg.substr(10), &threads)) {
+              cmSystemTools::Error("Invalid -E tar --threads= argument: " +
+                                   arg.substr(10));
+              return 1;
+            }
           } else if (arg == "--touch") {
             extractTimestamps = cmSystemTools::cmTarExtractTimestamps::No;
           } else {
@@ -1551,13 +1564,14 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args,
           std::cerr << "tar: No files or directories specified\n";
         }
         if (!cmSystemTools::CreateTar(outFile, files, {}, compress, verbose,
-                                      mtime, format)) {
+                                      mtime, format, 0,
+                                      static_cast<int>(threads))) {
           cmSystemTools::Error("Problem creating tar: " + outFile);
           return 1;
         }
       } else if (action == cmSystemTools::TarActionExtract) {
         if (!cmSystemTools::ExtractTar(outFile, files, extractTimestamps,
-                                       verbose)) {
+                                       verbose, static_cast<int>(threads))) {
           cmSystemTools::Error("Problem extracting tar: " + outFile);
           return 1;
         }
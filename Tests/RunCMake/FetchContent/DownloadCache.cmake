@@ -0,0 +1,51 @@
+include(FetchContent)
+
+set(ENV{CMAKE_DOWNLOAD_CACHE_DIR} ${CMAKE_CURRENT_BINARY_DIR}/cache)
+file(REMOVE_RECURSE ${CMAKE_CURRENT_BINARY_DIR}/cache)
+
+set(archive_dir ${CMAKE_CURRENT_BINARY_DIR}/archive)
+file(WRITE ${archive_dir}/t1/file.txt "content\n")
+file(ARCHIVE_CREATE
+  OUTPUT ${archive_dir}/t1.tar.gz
+  FORMAT paxr
+  COMPRESSION GZip
+  WORKING_DIRECTORY ${archive_dir}
+  PATHS t1
+)
+file(MD5 ${archive_dir}/t1.tar.gz md5_hash)
+
+if(NOT archive_dir MATCHES "^/")
+  set(slash /)
+endif()
+
+# Extract the archive, populating the cache.  A local archive is used
+# in place, so only its extracted tree is stored.
+FetchContent_Declare(
+  t1
+  URL file://${slash}${archive_dir}/t1.tar.gz
+  URL_HASH MD5=${md5_hash}
+  DOWNLOAD_EXTRACT_TIMESTAMP TRUE
+)
+FetchContent_MakeAvailable(t1)
+
+set(cache_tree ${CMAKE_CURRENT_BINARY_DIR}/cache/extracted/md5/${md5_hash})
+if(NOT EXISTS ${cache_tree}/t1/file.txt)
+  message(SEND_ERROR "Download cache does not contain ${cache_tree}")
+endif()
+if(NOT EXISTS ${t1_SOURCE_DIR}/file.txt)
+  message(SEND_ERROR "t1 was not populated")
+endif()
+
+# The same content is populated from the cached tree, not the archive.
+file(WRITE ${cache_tree}/t1/cached.txt "cached\n")
+FetchContent_Declare(
+  t2
+  URL file://${slash}${archive_dir}/t1.tar.gz
+  URL_HASH MD5=${md5_hash}
+  DOWNLOAD_EXTRACT_TIMESTAMP FALSE
+)
+FetchContent_MakeAvailable(t2)
+
+if(NOT EXISTS ${t2_SOURCE_DIR}/cached.txt)
+  message(SEND_ERROR "t2 was not populated from the download cache")
+endif()
@@ -27,6 +27,7 @@ block(SCOPE_FOR VARIABLES)
 endblock()
 run_cmake_with_cmp0168(DownloadTwice)
 run_cmake_with_cmp0168(DownloadFile)
+run_cmake_with_cmp0168(DownloadCache)
 run_cmake_with_cmp0168(IgnoreToolchainFile)
 run_cmake_with_cmp0168(System)
 run_cmake_with_cmp0168(VarDefinitions)
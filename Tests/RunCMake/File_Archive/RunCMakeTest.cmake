@@ -29,3 +29,8 @@ run_cmake(gnutar-gz-compression-level)
 run_cmake(pax-xz-compression-level)
 run_cmake(pax-zstd-compression-level)
 run_cmake(paxr-bz2-compression-level)
+
+run_cmake(threads)
+run_cmake(threads-invalid)
+run_cmake(extract-threads)
+run_cmake(extract-threads-invalid)
@@ -0,0 +1,3 @@
+file(ARCHIVE_EXTRACT
+  INPUT ${CMAKE_CURRENT_BINARY_DIR}/test.tar.gz
+  THREADS many)
@@ -0,0 +1,48 @@
+set(COMPRESS_DIR compress_dir)
+set(FULL_COMPRESS_DIR ${CMAKE_CURRENT_BINARY_DIR}/${COMPRESS_DIR})
+set(FULL_DECOMPRESS_DIR ${CMAKE_CURRENT_BINARY_DIR}/decompress_dir)
+set(OUTPUT_NAME ${CMAKE_CURRENT_BINARY_DIR}/test.tar.gz)
+
+file(REMOVE_RECURSE ${FULL_COMPRESS_DIR} ${FULL_DECOMPRESS_DIR})
+file(REMOVE ${OUTPUT_NAME})
+
+string(REPEAT "0123456789abcdefghijklmnopqrstuvwxyz\n" 4096 chunk)
+foreach(i RANGE 31)
+  string(MD5 salt "${i}")
+  file(WRITE ${FULL_COMPRESS_DIR}/d${i}/small.txt "${salt}\n")
+  file(WRITE ${FULL_COMPRESS_DIR}/d${i}/large.txt "${salt}${chunk}")
+  file(WRITE ${FULL_COMPRESS_DIR}/d${i}/empty.txt "")
+endforeach()
+if(NOT CMAKE_HOST_WIN32)
+  file(CREATE_LINK d0/small.txt ${FULL_COMPRESS_DIR}/link.txt SYMBOLIC)
+endif()
+
+file(ARCHIVE_CREATE
+  OUTPUT ${OUTPUT_NAME}
+  FORMAT paxr
+  COMPRESSION GZip
+  MTIME "2001-01-01 12:00:00 UTC"
+  PATHS ${COMPRESS_DIR})
+
+file(ARCHIVE_EXTRACT
+  INPUT ${OUTPUT_NAME}
+  DESTINATION ${FULL_DECOMPRESS_DIR}
+  THREADS 4)
+
+file(GLOB_RECURSE files RELATIVE ${FULL_COMPRESS_DIR} ${FULL_COMPRESS_DIR}/*)
+foreach(file IN LISTS files)
+  set(output ${FULL_DECOMPRESS_DIR}/${COMPRESS_DIR}/${file})
+  if(NOT EXISTS ${output})
+    message(SEND_ERROR "${file} was not extracted")
+    continue()
+  endif()
+  file(MD5 ${FULL_COMPRESS_DIR}/${file} input_md5)
+  file(MD5 ${output} output_md5)
+  if(NOT input_md5 STREQUAL output_md5)
+    message(SEND_ERROR "${file} differs after extraction")
+  endif()
+  file(TIMESTAMP ${output} mtime "%Y-%m-%d" UTC)
+  if(NOT mtime STREQUAL "2001-01-01")
+    message(SEND_ERROR "${file} has timestamp ${mtime}, not 2001-01-01")
+  endif()
+endforeach()
@@ -0,0 +1,6 @@
+file(ARCHIVE_CREATE
+  OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/test.tar.gz
+  FORMAT paxr
+  COMPRESSION GZip
+  THREADS many
+  PATHS ${CMAKE_CURRENT_LIST_FILE})
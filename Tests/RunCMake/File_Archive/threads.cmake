@@ -0,0 +1,48 @@
+set(COMPRESS_DIR compress_dir)
+set(FULL_COMPRESS_DIR ${CMAKE_CURRENT_BINARY_DIR}/${COMPRESS_DIR})
+set(FULL_DECOMPRESS_DIR ${CMAKE_CURRENT_BINARY_DIR}/decompress_dir)
+
+# Write enough data to span several independently compressed blocks.
+string(REPEAT "0123456789abcdefghijklmnopqrstuvwxyz\n" 1024 chunk)
+file(REMOVE_RECURSE ${FULL_COMPRESS_DIR})
+foreach(i RANGE 15)
+  string(MD5 salt "${i}")
+  file(WRITE ${FULL_COMPRESS_DIR}/big.txt "${salt}${chunk}" APPEND)
+  file(WRITE ${FULL_COMPRESS_DIR}/d${i}/f.txt "${salt}\n")
+endforeach()
+foreach(i RANGE 2)
+  file(READ ${FULL_COMPRESS_DIR}/big.txt content)
+  file(APPEND ${FULL_COMPRESS_DIR}/big.txt "${content}")
+endforeach()
+
+function(check_threads compression magic)
+  set(output ${CMAKE_CURRENT_BINARY_DIR}/test-${compression}.tar)
+  file(REMOVE ${output})
+  file(REMOVE_RECURSE ${FULL_DECOMPRESS_DIR})
+
+  file(ARCHIVE_CREATE
+    OUTPUT ${output}
+    FORMAT paxr
+    COMPRESSION ${compression}
+    THREADS 3
+    PATHS ${COMPRESS_DIR})
+
+  file(READ ${output} actual LIMIT 3 HEX)
+  if(NOT actual MATCHES "^${magic}")
+    message(SEND_ERROR "${compression} magic [${actual}] is not [${magic}]")
+  endif()
+
+  file(ARCHIVE_EXTRACT INPUT ${output} DESTINATION ${FULL_DECOMPRESS_DIR})
+
+  file(GLOB_RECURSE files RELATIVE ${FULL_COMPRESS_DIR} ${FULL_COMPRESS_DIR}/*)
+  foreach(file IN LISTS files)
+    file(MD5 ${FULL_COMPRESS_DIR}/${file} input_md5)
+    file(MD5 ${FULL_DECOMPRESS_DIR}/${COMPRESS_DIR}/${file} output_md5)
+    if(NOT input_md5 STREQUAL output_md5)
+      message(SEND_ERROR "${compression}: ${file} differs after round trip")
+    endif()
+  endforeach()
+endfunction()
+
+check_threads(GZip "1f8b")
+check_threads(BZip2 "425a68")
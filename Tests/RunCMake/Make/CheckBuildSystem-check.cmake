@@ -0,0 +1,12 @@
+set(check "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/Makefile.cmake.check")
+if(NOT EXISTS "${check}")
+  set(RunCMake_TEST_FAILED "Check file not found:\n  ${check}")
+  return()
+endif()
+file(STRINGS "${check}" lines)
+foreach(line IN ITEMS "D CMakeCache.txt" "D dep.txt" "O Makefile")
+  list(FIND lines "${line}" index)
+  if(index EQUAL -1)
+    string(APPEND RunCMake_TEST_FAILED "Check file\n  ${check}\ndoes not contain line:\n  ${line}\n")
+  endif()
+endforeach()
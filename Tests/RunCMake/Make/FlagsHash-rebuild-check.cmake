@@ -0,0 +1,5 @@
+if(NOT actual_stdout MATCHES "Building C object CMakeFiles/FlagsHash\\.dir/FlagsHashA\\.c\\.o")
+  set(RunCMake_TEST_FAILED "FlagsHashA.c was not rebuilt after its flags changed.")
+elseif(actual_stdout MATCHES "FlagsHashB\\.c")
+  set(RunCMake_TEST_FAILED "FlagsHashB.c was rebuilt although its flags did not change.")
+endif()
@@ -0,0 +1,3 @@
+enable_language(C)
+add_library(FlagsHash STATIC FlagsHashA.c FlagsHashB.c)
+set_property(SOURCE FlagsHashA.c PROPERTY COMPILE_DEFINITIONS "VALUE_A=${VALUE_A}")
@@ -0,0 +1,4 @@
+int flags_hash_a(void)
+{
+  return VALUE_A;
+}
@@ -0,0 +1,4 @@
+int flags_hash_b(void)
+{
+  return 0;
+}
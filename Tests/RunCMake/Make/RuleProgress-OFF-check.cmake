@@ -0,0 +1,7 @@
+set(build_make "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/CustomTarget.dir/build.make")
+file(STRINGS "${build_make}" echo_lines REGEX "Generating out\\.txt")
+if(NOT echo_lines)
+  set(RunCMake_TEST_FAILED "No rule message found in\n  ${build_make}")
+elseif(echo_lines MATCHES "cmake_echo_color")
+  set(RunCMake_TEST_FAILED "Rule message runs CMake in\n  ${build_make}\n${echo_lines}")
+endif()
@@ -0,0 +1,6 @@
+set_property(GLOBAL PROPERTY RULE_PROGRESS OFF)
+add_custom_command(OUTPUT out.txt
+  COMMAND ${CMAKE_COMMAND} -E touch out.txt
+  COMMENT "Generating out.txt"
+  )
+add_custom_target(CustomTarget ALL DEPENDS out.txt)
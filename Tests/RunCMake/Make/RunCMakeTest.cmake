@@ -16,6 +16,14 @@ run_TargetMessages(OFF)
 run_TargetMessages(VAR-ON -DCMAKE_TARGET_MESSAGES=ON)
 run_TargetMessages(VAR-OFF -DCMAKE_TARGET_MESSAGES=OFF)
 
+function(run_RuleProgress)
+  run_cmake(RuleProgress-OFF)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/RuleProgress-OFF-build)
+  run_cmake_command(RuleProgress-OFF-build ${CMAKE_COMMAND} --build .)
+endfunction()
+run_RuleProgress()
+
 function(run_VerboseBuild)
   run_cmake(VerboseBuild)
   set(RunCMake_TEST_NO_CLEAN 1)
@@ -41,6 +49,35 @@ run_VerboseBuild()
 
 run_cmake(IncludeRegexSubdir)
 
+function(run_CheckBuildSystem)
+  run_cmake(CheckBuildSystem)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/CheckBuildSystem-build)
+  set(check_build_system
+    ${CMAKE_COMMAND} -E env VERBOSE=1
+    ${CMAKE_COMMAND} -S ${RunCMake_SOURCE_DIR} -B ${RunCMake_TEST_BINARY_DIR}
+    --check-build-system CMakeFiles/Makefile.cmake 0
+    )
+  run_cmake_command(CheckBuildSystem-uptodate ${check_build_system})
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1)
+  file(TOUCH "${RunCMake_TEST_BINARY_DIR}/dep.txt")
+  run_cmake_command(CheckBuildSystem-touched ${check_build_system})
+endfunction()
+run_CheckBuildSystem()
+
+function(run_FlagsHash)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/FlagsHash-build)
+  set(RunCMake_TEST_OPTIONS -DVALUE_A=1)
+  run_cmake(FlagsHash)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  run_cmake_command(FlagsHash-build ${CMAKE_COMMAND} --build .)
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1)
+  set(RunCMake_TEST_OPTIONS -DVALUE_A=2)
+  run_cmake(FlagsHash)
+  run_cmake_command(FlagsHash-rebuild ${CMAKE_COMMAND} --build .)
+endfunction()
+run_FlagsHash()
+
 function(run_MakefileConflict)
   run_cmake(MakefileConflict)
   set(RunCMake_TEST_NO_CLEAN 1)
@@ -106,6 +106,8 @@ run_cmake_with_options(CustomCommandDepfileAsByproduct -DCMAKE_BUILD_TYPE=Debug)
 run_cmake(CustomCommandJobPool)
 run_cmake(JobPoolUsesTerminal)
 
+run_cmake(SharedCompileFlags)
+
 run_cmake(RspFileC)
 run_cmake(RspFileCXX)
 if(CMake_TEST_Fortran
@@ -0,0 +1,10 @@
+set(log "${RunCMake_BINARY_DIR}/SharedCompileFlags-build/build.ninja")
+file(READ "${log}" build_file)
+foreach(var IN ITEMS DEFINES INCLUDES)
+  if(NOT "${build_file}" MATCHES "\n${var}__shared_flags_[A-Za-z]*_1 = [^\n]+\n")
+    string(APPEND RunCMake_TEST_FAILED "Log file:\n ${log}\ndoes not define a shared ${var} variable\n")
+  endif()
+  if(NOT "${build_file}" MATCHES "\n  ${var} = \\\${${var}__shared_flags_[A-Za-z]*_1}\n")
+    string(APPEND RunCMake_TEST_FAILED "Log file:\n ${log}\ndoes not refer to the shared ${var} variable\n")
+  endif()
+endforeach()
@@ -0,0 +1,5 @@
+enable_language(C)
+
+add_library(shared_flags STATIC greeting.c greeting2.c)
+target_include_directories(shared_flags PRIVATE include1 include2)
+target_compile_definitions(shared_flags PRIVATE SHARED_FLAGS_DEFINE)
@@ -0,0 +1,7 @@
+file(STRINGS "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/rules.ninja" rules
+  REGEX "^rule C_COMPILER__")
+list(LENGTH rules rules_count)
+if(NOT rules_count EQUAL 1)
+  string(REPLACE ";" "\n  " rules_formatted "${rules}")
+  string(APPEND RunCMake_TEST_FAILED "Expected exactly one C compile rule, got:\n  ${rules_formatted}\n")
+endif()
@@ -0,0 +1,4 @@
+enable_language(C)
+
+add_executable(exe1 main.c)
+add_executable(exe2 main.c)
@@ -0,0 +1,23 @@
+# Run the fake gcov on .gcda files in the support directory of a target.
+# Every .gcda file reports common.h, so each gcov run writes a file of
+# the same name.
+# With FAKEGCOV_JSON, the "--" keeps cmake from handling the --help
+# option that ctest passes to check for JSON support.
+set(CTEST_COVERAGE_COMMAND "${CMAKE_COMMAND}")
+if(FAKEGCOV_JSON)
+  set(CTEST_COVERAGE_EXTRA_FLAGS
+    "-DFAKEGCOV_JSON=1 -P \"${CMAKE_CURRENT_LIST_DIR}/fakegcov.cmake\" --")
+else()
+  set(CTEST_COVERAGE_EXTRA_FLAGS
+    "-P \"${CMAKE_CURRENT_LIST_DIR}/fakegcov.cmake\"")
+endif()
+
+set(src "${CTEST_SOURCE_DIRECTORY}")
+foreach(name IN ITEMS a.c b.c c.c common.h)
+  file(WRITE "${src}/${name}" "1\n2\n3\n")
+endforeach()
+
+set(dir "${CTEST_BINARY_DIRECTORY}/CMakeFiles/cov.dir")
+file(WRITE "${dir}/a.gcda" "${src}/a.c|1|0|-\n${src}/common.h|2|-|0\n")
+file(WRITE "${dir}/b.gcda" "${src}/b.c|-|4|4\n${src}/common.h|3|-|1\n")
+file(WRITE "${dir}/c.gcda" "${src}/c.c|5|5|5\n${src}/common.h|0|-|0\n")
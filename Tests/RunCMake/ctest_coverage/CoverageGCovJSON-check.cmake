@@ -0,0 +1,14 @@
+# gcov JSON omits lines that are not executable, yet the coverage
+# reported must match that of the .gcov text files.
+foreach(case IN ITEMS CoverageGCovSerial CoverageGCovJSON)
+  file(GLOB log
+    "${RunCMake_BINARY_DIR}/${case}-build/Testing/*/CoverageLog-0.xml")
+  file(READ "${log}" log)
+  string(REGEX MATCH "<File .*</File>" ${case} "${log}")
+endforeach()
+if(CoverageGCovJSON STREQUAL "")
+  set(RunCMake_TEST_FAILED "No coverage was read from gcov JSON.")
+elseif(NOT CoverageGCovJSON STREQUAL CoverageGCovSerial)
+  set(RunCMake_TEST_FAILED "Coverage differs from the gcov text format:\n"
+    "${CoverageGCovJSON}\nexpected:\n${CoverageGCovSerial}")
+endif()
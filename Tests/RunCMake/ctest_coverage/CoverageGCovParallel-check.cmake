@@ -0,0 +1,16 @@
+if(NOT IS_DIRECTORY "${RunCMake_TEST_BINARY_DIR}/Testing/CoverageInfo/gcov1")
+  set(RunCMake_TEST_FAILED "gcov did not run in a second worker directory.")
+  return()
+endif()
+
+# The coverage reported must match that of the serial run.
+foreach(case IN ITEMS CoverageGCovSerial CoverageGCovParallel)
+  file(GLOB log
+    "${RunCMake_BINARY_DIR}/${case}-build/Testing/*/CoverageLog-0.xml")
+  file(READ "${log}" log)
+  string(REGEX MATCH "<File .*</File>" ${case} "${log}")
+endforeach()
+if(NOT CoverageGCovParallel STREQUAL CoverageGCovSerial)
+  set(RunCMake_TEST_FAILED "Coverage differs from the serial run:\n"
+    "${CoverageGCovParallel}\nexpected:\n${CoverageGCovSerial}")
+endif()
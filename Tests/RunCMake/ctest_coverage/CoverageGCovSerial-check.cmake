@@ -0,0 +1,9 @@
+file(GLOB log "${RunCMake_TEST_BINARY_DIR}/Testing/*/CoverageLog-0.xml")
+file(READ "${log}" log)
+string(REGEX REPLACE "[\t\n]" "" log "${log}")
+set(common [[<File Name="common.h" FullPath="./common.h"><Report><Line Number="0" Count="5">1</Line><Line Number="1" Count="-1">2</Line><Line Number="2" Count="1">3</Line></Report></File>]])
+string(FIND "${log}" "${common}" pos)
+if(pos EQUAL -1)
+  set(RunCMake_TEST_FAILED
+    "Counts of common.h from all gcov runs were not merged in:\n  ${log}")
+endif()
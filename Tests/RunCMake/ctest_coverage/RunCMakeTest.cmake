@@ -1,6 +1,8 @@
 include(RunCTest)
 
 set(CASE_CTEST_COVERAGE_ARGS "")
+set(CASE_TEST_PREFIX_CODE "")
+set(CASE_CMAKELISTS_SUFFIX_CODE "")
 
 function(run_ctest_coverage CASE_NAME)
   set(CASE_CTEST_COVERAGE_ARGS "${ARGN}")
@@ -8,3 +10,14 @@ function(run_ctest_coverage CASE_NAME)
 endfunction()
 
 run_ctest_coverage(CoverageQuiet QUIET)
+
+function(run_ctest_coverage_gcov CASE_NAME)
+  string(APPEND CASE_TEST_PREFIX_CODE "include(\"${RunCMake_SOURCE_DIR}/CoverageGCov.cmake\")")
+  set(CASE_CMAKELISTS_SUFFIX_CODE "add_custom_target(cov)")
+  run_ctest(${CASE_NAME} ${ARGN})
+endfunction()
+run_ctest_coverage_gcov(CoverageGCovSerial -j1)
+run_ctest_coverage_gcov(CoverageGCovParallel -j2)
+set(CASE_TEST_PREFIX_CODE "set(FAKEGCOV_JSON 1)\n")
+run_ctest_coverage_gcov(CoverageGCovJSON -j1)
+set(CASE_TEST_PREFIX_CODE "")
@@ -0,0 +1,82 @@
+# Fake gcov.  For each "<source>|<count>|..." line of the given .gcda
+# file, write a .gcov file to the working directory and report it the
+# way gcov does.  A count of "-" marks a line that is not executable.
+#
+# With FAKEGCOV_JSON, act as a gcov that reports in the JSON format on
+# its standard output instead, and that cannot write .gcov files.
+set(gcda "")
+set(help 0)
+set(json 0)
+math(EXPR last "${CMAKE_ARGC} - 1")
+foreach(i RANGE 0 ${last})
+  if(CMAKE_ARGV${i} MATCHES "\\.gcda$")
+    set(gcda "${CMAKE_ARGV${i}}")
+  elseif(CMAKE_ARGV${i} STREQUAL "--help")
+    set(help 1)
+  elseif(CMAKE_ARGV${i} STREQUAL "--json-format")
+    set(json 1)
+  endif()
+endforeach()
+if(FAKEGCOV_JSON)
+  if(help)
+    execute_process(COMMAND ${CMAKE_COMMAND} -E echo
+      "  -j, --json-format               Output JSON intermediate format\n"
+      "  -t, --stdout                    Output to stdout instead of a file")
+    return()
+  endif()
+  if(NOT json)
+    message(FATAL_ERROR "Only --json-format is supported.")
+  endif()
+endif()
+if(gcda STREQUAL "")
+  return()
+endif()
+
+set(output "")
+set(json_cwd "")
+set(json_files "")
+file(STRINGS "${gcda}" entries)
+foreach(entry IN LISTS entries)
+  string(REPLACE "|" ";" counts "${entry}")
+  list(POP_FRONT counts source)
+  get_filename_component(name "${source}" NAME)
+  get_filename_component(json_cwd "${source}" DIRECTORY)
+  set(gcov "        -:    0:Source:${source}\n")
+  set(json_lines "")
+  set(line 0)
+  foreach(count IN LISTS counts)
+    math(EXPR line "${line} + 1")
+    if(NOT count STREQUAL "-")
+      string(APPEND json_lines
+        ",{\"line_number\":${line},\"count\":${count}}")
+    endif()
+    if(count STREQUAL "0")
+      set(count "#####")
+    endif()
+    string(LENGTH "${count}" length)
+    math(EXPR length "9 - ${length}")
+    string(REPEAT " " ${length} count_pad)
+    string(LENGTH "${line}" length)
+    math(EXPR length "5 - ${length}")
+    string(REPEAT " " ${length} line_pad)
+    string(APPEND gcov "${count_pad}${count}:${line_pad}${line}:\n")
+  endforeach()
+  string(SUBSTRING "${json_lines}" 1 -1 json_lines)
+  string(APPEND json_files
+    ",{\"file\":\"${name}\",\"lines\":[${json_lines}]}")
+  if(NOT FAKEGCOV_JSON)
+    file(WRITE "${name}.gcov" "${gcov}")
+  endif()
+  list(LENGTH counts length)
+  string(APPEND output "File '${source}'\n"
+    "Lines executed:100.00% of ${length}\n"
+    "Creating '${name}.gcov'\n\n")
+endforeach()
+if(FAKEGCOV_JSON)
+  string(SUBSTRING "${json_files}" 1 -1 json_files)
+  set(output "{\"format_version\":\"1\","
+    "\"current_working_directory\":\"${json_cwd}\","
+    "\"files\":[${json_files}]}")
+  string(CONCAT output ${output})
+endif()
+execute_process(COMMAND ${CMAKE_COMMAND} -E echo "${output}")
@@ -0,0 +1,37 @@
+execute_process(ASYNC a
+  COMMAND ${CMAKE_COMMAND} -E echo "a"
+  OUTPUT_VARIABLE out_a
+  RESULT_VARIABLE res_a
+  OUTPUT_STRIP_TRAILING_WHITESPACE
+)
+execute_process(ASYNC b
+  COMMAND ${CMAKE_COMMAND} -E true
+  COMMAND ${CMAKE_COMMAND} -E echo "b"
+  OUTPUT_VARIABLE out_b
+  RESULTS_VARIABLE res_b
+  OUTPUT_STRIP_TRAILING_WHITESPACE
+)
+if(DEFINED out_a OR DEFINED res_a OR DEFINED out_b OR DEFINED res_b)
+  message(FATAL_ERROR "ASYNC set variables before WAIT")
+endif()
+
+execute_process(
+  COMMAND ${CMAKE_COMMAND} -E echo "sync"
+  OUTPUT_VARIABLE out_sync
+  OUTPUT_STRIP_TRAILING_WHITESPACE
+)
+if(NOT out_sync STREQUAL "sync")
+  message(FATAL_ERROR "sync output is:\n  \"${out_sync}\"")
+endif()
+
+execute_process(WAIT b a)
+if(NOT out_a STREQUAL "a" OR NOT res_a STREQUAL "0")
+  message(FATAL_ERROR "ASYNC a gave:\n  \"${out_a}\" \"${res_a}\"")
+endif()
+if(NOT out_b STREQUAL "b" OR NOT res_b STREQUAL "0;0")
+  message(FATAL_ERROR "ASYNC b gave:\n  \"${out_b}\" \"${res_b}\"")
+endif()
+
+# A name may be reused once it has been waited for.
+execute_process(ASYNC a COMMAND ${CMAKE_COMMAND} -E true)
+execute_process(WAIT a)
@@ -0,0 +1,7 @@
+execute_process(ASYNC fail
+  COMMAND ${CMAKE_COMMAND} -E false
+  COMMAND_ERROR_IS_FATAL ANY
+)
+message(STATUS "Launched")
+execute_process(WAIT fail)
+message(STATUS "Not reached")
@@ -0,0 +1,2 @@
+execute_process(ASYNC job COMMAND ${CMAKE_COMMAND} -E true)
+execute_process(ASYNC job COMMAND ${CMAKE_COMMAND} -E true)
@@ -0,0 +1,49 @@
+execute_process(
+  COMMAND ${CMAKE_COMMAND} -E echo "0123456789"
+  OUTPUT_VARIABLE out
+  OUTPUT_LIMIT 4
+  ECHO_OUTPUT_VARIABLE
+)
+if(NOT out STREQUAL "0123")
+  message(FATAL_ERROR "OUTPUT_LIMIT 4 stored:\n  \"${out}\"")
+endif()
+
+execute_process(
+  COMMAND ${CMAKE_COMMAND} -E echo "0123456789"
+  OUTPUT_VARIABLE out
+  OUTPUT_LIMIT 0
+)
+if(NOT out STREQUAL "")
+  message(FATAL_ERROR "OUTPUT_LIMIT 0 stored:\n  \"${out}\"")
+endif()
+
+execute_process(
+  COMMAND ${CMAKE_COMMAND} -E echo "0123456789"
+  OUTPUT_VARIABLE out
+  OUTPUT_LIMIT 100
+  OUTPUT_STRIP_TRAILING_WHITESPACE
+)
+if(NOT out STREQUAL "0123456789")
+  message(FATAL_ERROR "OUTPUT_LIMIT 100 stored:\n  \"${out}\"")
+endif()
+
+string(ASCII 195 169 e_acute)
+execute_process(
+  COMMAND ${CMAKE_COMMAND} -E echo "${e_acute}${e_acute}"
+  OUTPUT_VARIABLE out
+  OUTPUT_LIMIT 3
+)
+if(NOT out STREQUAL "${e_acute}")
+  message(FATAL_ERROR "OUTPUT_LIMIT 3 split a character:\n  \"${out}\"")
+endif()
+
+execute_process(
+  COMMAND ${CMAKE_COMMAND} -E echo "${e_acute}${e_acute}"
+  OUTPUT_VARIABLE out
+  OUTPUT_LIMIT 3
+  ENCODING NONE
+)
+string(LENGTH "${out}" len)
+if(NOT len EQUAL 3)
+  message(FATAL_ERROR "OUTPUT_LIMIT 3 with ENCODING NONE stored ${len} bytes:\n  \"${out}\"")
+endif()
@@ -0,0 +1 @@
+execute_process(COMMAND ${CMAKE_COMMAND} -E true OUTPUT_VARIABLE out OUTPUT_LIMIT -1)
@@ -30,6 +30,12 @@ run_cmake_command(EchoCommand3 ${CMAKE_COMMAND}
   ${RunCMake_SOURCE_DIR}/EchoCommand.cmake)
 
 run_cmake_command(EchoVariable ${CMAKE_COMMAND} -P ${RunCMake_SOURCE_DIR}/EchoVariable.cmake)
+run_cmake_script(OutputLimit)
+run_cmake_script(OutputLimitBad)
+run_cmake_script(Async)
+run_cmake_script(AsyncFatal)
+run_cmake_script(AsyncPending)
+run_cmake_script(WaitUnknown)
 
 run_cmake_command(CommandError ${CMAKE_COMMAND} -P ${RunCMake_SOURCE_DIR}/CommandError.cmake)
 run_cmake_command(AnyCommandError ${CMAKE_COMMAND} -P ${RunCMake_SOURCE_DIR}/AnyCommandError.cmake)
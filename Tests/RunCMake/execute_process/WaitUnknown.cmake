@@ -0,0 +1 @@
+execute_process(WAIT unknown)
@@ -22,6 +22,7 @@ run_cmake(file-without-path)
 run_cmake(no-file)
 run_cmake(range)
 run_cmake(SHOW_PROGRESS)
+run_cmake(download-cache)
 
 if(NOT CMake_TEST_NO_NETWORK)
   run_cmake(bad-hostname)
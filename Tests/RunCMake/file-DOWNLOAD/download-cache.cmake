@@ -0,0 +1,32 @@
+include(common.cmake)
+
+set(CMAKE_DOWNLOAD_CACHE_DIR ${CMAKE_CURRENT_BINARY_DIR}/cache)
+set(entry ${CMAKE_DOWNLOAD_CACHE_DIR}/md5/dbd330d52f4dbd60115d4191904ded92)
+file(REMOVE_RECURSE ${CMAKE_DOWNLOAD_CACHE_DIR})
+file(REMOVE ${file})
+
+# Actually download the file and populate the cache.
+file_download(EXPECTED_MD5 dbd330d52f4dbd60115d4191904ded92)
+if(NOT EXISTS "${entry}")
+  message(SEND_ERROR "Download cache entry not created:\n  ${entry}")
+endif()
+
+# Get the file from the cache without contacting the URL.
+set(url "file:///cmake-download-cache-does-not-exist/input.png")
+set(file ${CMAKE_CURRENT_BINARY_DIR}/output-cached.png)
+file(REMOVE ${file})
+file_download(EXPECTED_MD5 dbd330d52f4dbd60115d4191904ded92)
+file(MD5 ${file} md5)
+if(NOT md5 STREQUAL "dbd330d52f4dbd60115d4191904ded92")
+  message(SEND_ERROR "File from download cache has MD5 ${md5}")
+endif()
+
+# A corrupt cache entry is replaced by a fresh download.
+file(REMOVE ${file} ${entry})
+file(WRITE ${entry} "corrupt")
+set(url "file://${slash}${CMAKE_CURRENT_SOURCE_DIR}/input.png")
+file_download(EXPECTED_MD5 dbd330d52f4dbd60115d4191904ded92)
+file(MD5 ${entry} md5)
+if(NOT md5 STREQUAL "dbd330d52f4dbd60115d4191904ded92")
+  message(SEND_ERROR "Corrupt download cache entry was not replaced")
+endif()
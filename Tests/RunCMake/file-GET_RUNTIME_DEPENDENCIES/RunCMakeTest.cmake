@@ -73,6 +73,8 @@ elseif(CMAKE_HOST_SYSTEM_NAME STREQUAL "Linux")
   run_install_test(linux-conflict)
   run_install_test(linux-notfile)
   run_install_test(linux-indirect-dependencies)
+  run_install_test(linux-builtin-tool)
+  run_install_test(linux-builtin-ldconfig-cache)
   run_cmake(project)
   run_cmake(badargs1)
   run_cmake(badargs2)
@@ -0,0 +1,140 @@
+enable_language(C)
+cmake_policy(SET CMP0095 NEW)
+
+file(WRITE "${CMAKE_BINARY_DIR}/D.c" "void libD(void) {}\n")
+file(WRITE "${CMAKE_BINARY_DIR}/E.c" "void libE(void) {}\n")
+file(WRITE "${CMAKE_BINARY_DIR}/F.c" "void libF(void) {}\n")
+file(WRITE "${CMAKE_BINARY_DIR}/mainDF.c" [[
+extern void libD(void);
+extern void libF(void);
+
+int main(void)
+{
+    libD();
+    libF();
+    return 0;
+}
+]])
+
+# Write a dynamic loader cache in the glibc layout, optionally preceded
+# by the old format.  Arguments: <file> <both|new> [<soname> <path>]...
+file(WRITE "${CMAKE_BINARY_DIR}/mkldcache.c" [[
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static void put32(FILE* f, uint32_t v)
+{
+  fwrite(&v, sizeof(v), 1, f);
+}
+
+int main(int argc, char** argv)
+{
+  FILE* f;
+  uint32_t i;
+  uint32_t n;
+  uint32_t strings = 0;
+  uint32_t offset;
+  long pos;
+  if (argc < 3 || (argc - 3) % 2 != 0) {
+    return 1;
+  }
+  n = (uint32_t)(argc - 3) / 2;
+  for (i = 3; i < (uint32_t)argc; ++i) {
+    strings += (uint32_t)strlen(argv[i]) + 1;
+  }
+  f = fopen(argv[1], "wb");
+  if (!f) {
+    return 1;
+  }
+
+  if (strcmp(argv[2], "both") == 0) {
+    fwrite("ld.so-1.7.0\0", 1, 12, f);
+    put32(f, n);
+    for (i = 0; i < n; ++i) {
+      put32(f, 1);
+      put32(f, 0);
+      put32(f, 0);
+    }
+    for (pos = ftell(f); pos % 8 != 0; ++pos) {
+      fputc(0, f);
+    }
+  }
+
+  fwrite("glibc-ld.so.cache1.1", 1, 20, f);
+  put32(f, n);
+  put32(f, strings);
+  for (i = 0; i < 5; ++i) {
+    put32(f, 0);
+  }
+  offset = 48 + n * 24;
+  for (i = 0; i < n; ++i) {
+    put32(f, 0x0303);
+    put32(f, offset);
+    offset += (uint32_t)strlen(argv[3 + 2 * i]) + 1;
+    put32(f, offset);
+    offset += (uint32_t)strlen(argv[4 + 2 * i]) + 1;
+    put32(f, 0);
+    put32(f, 0);
+    put32(f, 0);
+  }
+  for (i = 3; i < (uint32_t)argc; ++i) {
+    fwrite(argv[i], 1, strlen(argv[i]) + 1, f);
+  }
+  return fclose(f) == 0 ? 0 : 1;
+}
+]])
+add_executable(mkldcache "${CMAKE_BINARY_DIR}/mkldcache.c")
+
+# Both directories provide libD.so.  The cache names libX first because
+# of the libE.so entry, but maps libD.so to the copy in libY.
+set(lib_dirX "${CMAKE_BINARY_DIR}/libX")
+set(lib_dirY "${CMAKE_BINARY_DIR}/libY")
+file(MAKE_DIRECTORY ${lib_dirX})
+file(MAKE_DIRECTORY ${lib_dirY})
+
+add_library(D SHARED "${CMAKE_BINARY_DIR}/D.c")
+set_property(TARGET D PROPERTY LIBRARY_OUTPUT_DIRECTORY ${lib_dirY})
+
+add_library(DX SHARED "${CMAKE_BINARY_DIR}/D.c")
+set_target_properties(DX PROPERTIES
+    OUTPUT_NAME D
+    LIBRARY_OUTPUT_DIRECTORY ${lib_dirX}
+)
+
+add_library(E SHARED "${CMAKE_BINARY_DIR}/E.c")
+set_property(TARGET E PROPERTY LIBRARY_OUTPUT_DIRECTORY ${lib_dirX})
+
+# libF.so is missing from the cache and found through its directory.
+add_library(F SHARED "${CMAKE_BINARY_DIR}/F.c")
+set_property(TARGET F PROPERTY LIBRARY_OUTPUT_DIRECTORY ${lib_dirX})
+
+add_executable(exe "${CMAKE_BINARY_DIR}/mainDF.c")
+target_link_libraries(exe D F)
+add_dependencies(exe DX E)
+set_property(TARGET exe PROPERTY SKIP_BUILD_RPATH 1)
+
+install(CODE [[
+    set(CMAKE_GET_RUNTIME_DEPENDENCIES_TOOL "builtin")
+    set(CMAKE_LDCONFIG_TOOL "builtin")
+
+    foreach(format IN ITEMS both new)
+        set(CMAKE_LDCONFIG_CACHE "${CMAKE_BINARY_DIR}/ld.so.cache-${format}")
+        execute_process(
+            COMMAND "$<TARGET_FILE:mkldcache>" "${CMAKE_LDCONFIG_CACHE}" ${format}
+                libE.so "$<TARGET_FILE:E>"
+                libD.so "$<TARGET_FILE:D>"
+            COMMAND_ERROR_IS_FATAL ANY
+        )
+
+        file(GET_RUNTIME_DEPENDENCIES
+            RESOLVED_DEPENDENCIES_VAR RESOLVED
+            PRE_INCLUDE_REGEXES "^lib[DF]\\.so$"
+            PRE_EXCLUDE_REGEXES ".*"
+            EXECUTABLES
+                "$<TARGET_FILE:exe>"
+        )
+        list(SORT RESOLVED)
+        message(STATUS "Resolved dependencies (${format}): ${RESOLVED}")
+    endforeach()
+]])
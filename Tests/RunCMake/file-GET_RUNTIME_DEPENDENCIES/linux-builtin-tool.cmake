@@ -0,0 +1,2 @@
+set(CMAKE_GET_RUNTIME_DEPENDENCIES_TOOL "builtin")
+include(${CMAKE_CURRENT_LIST_DIR}/linux-indirect-dependencies.cmake)
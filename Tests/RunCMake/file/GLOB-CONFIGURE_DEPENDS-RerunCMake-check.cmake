@@ -0,0 +1,10 @@
+set(data "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/VerifyGlobs.json")
+if(NOT EXISTS "${data}")
+  set(RunCMake_TEST_FAILED "Glob verification data file not generated:\n  ${data}")
+  return()
+endif()
+file(READ "${data}" json)
+string(JSON dir GET "${json}" globs 0 directories 0 path)
+if(NOT dir STREQUAL "${RunCMake_TEST_BINARY_DIR}/test")
+  set(RunCMake_TEST_FAILED "Glob verification data file does not record\n  ${RunCMake_TEST_BINARY_DIR}/test\nbut:\n  ${dir}")
+endif()
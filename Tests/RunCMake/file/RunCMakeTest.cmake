@@ -146,6 +146,8 @@ else()
   file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}/test")
   set(tf_1  "${RunCMake_TEST_BINARY_DIR}/test/1.txt")
   file(WRITE "${tf_1}" "1")
+  # Age the globbed directory so its modification time is recorded.
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 2.125)
 
   message(STATUS "GLOB-CONFIGURE_DEPENDS-RerunCMake: first configuration...")
   run_cmake(GLOB-CONFIGURE_DEPENDS-RerunCMake)